@@ -0,0 +1,202 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Test case for agglomerative clustering.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#define BOOST_TEST_MODULE Algorithms_AgglomerativeClustering
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/AgglomerativeClustering.h>
+#include <shark/Models/Trees/AgglomerativeTree.h>
+#include <shark/Models/Clustering/HierarchicalClustering.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace shark;
+
+namespace{
+//linkage of two clusters computed from all pairs of points
+double naiveLinkage(
+	std::vector<RealVector> const& points,
+	std::vector<std::size_t> const& a, std::vector<std::size_t> const& b,
+	AgglomerativeLinkage linkage
+){
+	if(linkage == WardLinkage){
+		RealVector ca(points[0].size(),0.0);
+		RealVector cb(points[0].size(),0.0);
+		for(std::size_t i = 0; i != a.size(); ++i) ca += points[a[i]] / double(a.size());
+		for(std::size_t i = 0; i != b.size(); ++i) cb += points[b[i]] / double(b.size());
+		double na = a.size(), nb = b.size();
+		return std::sqrt(2 * na * nb / (na + nb)) * norm_2(ca - cb);
+	}
+	double minDist = std::numeric_limits<double>::max();
+	double maxDist = 0;
+	double sumDist = 0;
+	for(std::size_t i = 0; i != a.size(); ++i){
+		for(std::size_t j = 0; j != b.size(); ++j){
+			double d = norm_2(points[a[i]] - points[b[j]]);
+			minDist = std::min(minDist,d);
+			maxDist = std::max(maxDist,d);
+			sumDist += d;
+		}
+	}
+	if(linkage == SingleLinkage) return minDist;
+	if(linkage == CompleteLinkage) return maxDist;
+	return sumDist / (a.size() * b.size());
+}
+
+//O(n^3) agglomerative clustering, returns the distance of every merge and the merged sets
+std::vector<std::pair<double, std::vector<std::size_t> > > naiveClustering(
+	std::vector<RealVector> const& points, AgglomerativeLinkage linkage
+){
+	std::vector<std::vector<std::size_t> > clusters(points.size());
+	for(std::size_t i = 0; i != points.size(); ++i)
+		clusters[i].push_back(i);
+	std::vector<std::pair<double, std::vector<std::size_t> > > result;
+	while(clusters.size() > 1){
+		double best = std::numeric_limits<double>::max();
+		std::size_t bestI = 0, bestJ = 0;
+		for(std::size_t i = 0; i != clusters.size(); ++i){
+			for(std::size_t j = i + 1; j != clusters.size(); ++j){
+				double d = naiveLinkage(points, clusters[i], clusters[j], linkage);
+				if(d < best){
+					best = d;
+					bestI = i;
+					bestJ = j;
+				}
+			}
+		}
+		clusters[bestI].insert(clusters[bestI].end(), clusters[bestJ].begin(), clusters[bestJ].end());
+		std::sort(clusters[bestI].begin(),clusters[bestI].end());
+		clusters.erase(clusters.begin() + bestJ);
+		result.push_back(std::make_pair(best, clusters[bestI]));
+	}
+	return result;
+}
+
+//the points of a cluster given by the merges
+std::vector<std::size_t> clusterPoints(std::vector<ClusterMerge> const& merges, std::size_t cluster){
+	std::size_t n = merges.size() + 1;
+	std::vector<std::size_t> result;
+	std::vector<std::size_t> stack(1,cluster);
+	while(!stack.empty()){
+		std::size_t c = stack.back();
+		stack.pop_back();
+		if(c < n){
+			result.push_back(c);
+		}else{
+			stack.push_back(merges[c - n].left);
+			stack.push_back(merges[c - n].right);
+		}
+	}
+	std::sort(result.begin(),result.end());
+	return result;
+}
+}
+
+BOOST_AUTO_TEST_SUITE (Algorithms_AgglomerativeClustering)
+
+BOOST_AUTO_TEST_CASE( AgglomerativeClustering_Linkages )
+{
+	Rng::seed(42);
+	std::size_t n = 60;
+	std::vector<RealVector> points(n, RealVector(3));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			points[i](j) = Rng::gauss(0,1);
+		}
+	}
+	Data<RealVector> data = createDataFromRange(points, 16);
+
+	AgglomerativeLinkage linkages[] = {SingleLinkage, CompleteLinkage, AverageLinkage, WardLinkage};
+	for(std::size_t l = 0; l != 4; ++l){
+		std::vector<ClusterMerge> merges = agglomerativeClustering(data, linkages[l]);
+		std::vector<std::pair<double, std::vector<std::size_t> > > reference = naiveClustering(points, linkages[l]);
+		BOOST_REQUIRE_EQUAL(merges.size(), n - 1);
+		//the naive algorithm merges in the order of the distances if the linkage is monotone
+		for(std::size_t i = 0; i != n - 1; ++i){
+			BOOST_CHECK_CLOSE(merges[i].distance, reference[i].first, 1.e-10);
+			BOOST_CHECK(merges[i].left < merges[i].right);
+			BOOST_CHECK(merges[i].right < n + i);
+			std::vector<std::size_t> cluster = clusterPoints(merges, n + i);
+			BOOST_CHECK_EQUAL(merges[i].size, cluster.size());
+			BOOST_CHECK_EQUAL_COLLECTIONS(cluster.begin(), cluster.end(), reference[i].second.begin(), reference[i].second.end());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( AgglomerativeClustering_HierarchicalClustering )
+{
+	Rng::seed(42);
+	//four well separated clusters
+	std::size_t n = 200;
+	std::vector<RealVector> points(n, RealVector(2));
+	std::vector<std::size_t> labels(n);
+	for(std::size_t i = 0; i != n; ++i){
+		labels[i] = i % 4;
+		points[i](0) = 10.0 * (labels[i] % 2) + Rng::gauss(0,1);
+		points[i](1) = 10.0 * (labels[i] / 2) + Rng::gauss(0,1);
+	}
+	Data<RealVector> data = createDataFromRange(points, 32);
+
+	AgglomerativeLinkage linkages[] = {SingleLinkage, CompleteLinkage, AverageLinkage, WardLinkage};
+	for(std::size_t l = 0; l != 4; ++l){
+		std::vector<ClusterMerge> merges = agglomerativeClustering(data, linkages[l]);
+		AgglomerativeTree<RealVector> tree(data, merges, 4);
+		BOOST_CHECK_EQUAL(tree.nodes(), 7u);
+		HierarchicalClustering<RealVector> model(&tree);
+		BOOST_REQUIRE_EQUAL(model.numberOfClusters(), 4u);
+
+		//points of the same cluster must be assigned to the same cluster of the model
+		UIntVector assignment = model.hardMembership(createBatch<RealVector>(points));
+		std::vector<std::size_t> clusterOfLabel(4, 4);
+		for(std::size_t i = 0; i != n; ++i){
+			unsigned int c = assignment(i);
+			if(clusterOfLabel[labels[i]] == 4)
+				clusterOfLabel[labels[i]] = c;
+			BOOST_CHECK_EQUAL(clusterOfLabel[labels[i]], c);
+		}
+		std::sort(clusterOfLabel.begin(),clusterOfLabel.end());
+		for(std::size_t c = 0; c != 4; ++c)
+			BOOST_CHECK_EQUAL(clusterOfLabel[c], c);
+
+		//the leaves of the tree cover the points of the clusters
+		for(std::size_t i = 0; i != n; ++i){
+			BOOST_CHECK_EQUAL(clusterOfLabel[labels[tree.index(i)]], clusterOfLabel[labels[tree.index(i / 50 * 50)]]);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -237,4 +237,140 @@ BOOST_AUTO_TEST_CASE(Kernel_KMeans_multiple_gauss)
 	}
 }
 
+//the pruned iterations must give the same result as plain Lloyd iterations
+BOOST_AUTO_TEST_CASE(KMeans_Lloyd)
+{
+	Rng::seed(42);
+	const std::size_t numPoints = 2000;
+	const std::size_t numDimensions = 4;
+	const std::size_t k = 12;
+	std::vector<RealVector> data(numPoints,RealVector(numDimensions));
+	for (std::size_t i=0; i<numPoints; i++){
+		for (std::size_t j=0; j <numDimensions; j++){
+			data[i](j) = Rng::gauss() + 3.0 * (i % 5 == j);
+		}
+	}
+	Data<RealVector> dataset = createDataFromRange(data,100);
+	std::vector<RealVector> start(data.begin(),data.begin()+k);
+
+	//plain Lloyd iterations
+	std::vector<RealVector> centers = start;
+	std::vector<std::size_t> assignment(numPoints,k);
+	std::size_t lloydIterations = 0;
+	for(;;++lloydIterations){
+		bool changed = false;
+		for(std::size_t i = 0; i != numPoints; ++i){
+			std::size_t best = 0;
+			for(std::size_t c = 1; c != k; ++c){
+				if(distanceSqr(data[i],centers[c]) < distanceSqr(data[i],centers[best]))
+					best = c;
+			}
+			changed |= assignment[i] != best;
+			assignment[i] = best;
+		}
+		if(!changed) break;
+		std::vector<RealVector> sums(k,RealVector(numDimensions,0.0));
+		std::vector<std::size_t> sizes(k,0);
+		for(std::size_t i = 0; i != numPoints; ++i){
+			sums[assignment[i]] += data[i];
+			++sizes[assignment[i]];
+		}
+		for(std::size_t c = 0; c != k; ++c){
+			BOOST_REQUIRE(sizes[c] > 0);
+			centers[c] = sums[c] / sizes[c];
+		}
+	}
+
+	Centroids centroids(createDataFromRange(start));
+	std::size_t iterations = kMeans(dataset, k, centroids);
+	BOOST_CHECK_EQUAL(iterations, lloydIterations);
+	for(std::size_t c = 0; c != k; ++c){
+		BOOST_CHECK_SMALL(distanceSqr(centroids.centroids().element(c),centers[c]), 1.e-20);
+	}
+}
+
+//with well separated clusters, the seeding picks one point of every cluster
+BOOST_AUTO_TEST_CASE(KMeans_Seeding)
+{
+	Rng::seed(42);
+	const std::size_t numPoints = 1000;
+	const std::size_t k = 5;
+	std::vector<RealVector> data(numPoints,RealVector(2));
+	for (std::size_t i=0; i<numPoints; i++){
+		data[i](0) = Rng::uni(0,1) + 100.0 * (i % k);
+		data[i](1) = Rng::uni(0,1);
+	}
+	Data<RealVector> dataset = createDataFromRange(data);
+
+	for(std::size_t trial = 0; trial != 10; ++trial){
+		Centroids plusPlus;
+		initKMeansPlusPlus(dataset, k, plusPlus);
+		Centroids parallel;
+		initKMeansParallel(dataset, k, parallel);
+		BOOST_REQUIRE_EQUAL(plusPlus.numberOfClusters(), k);
+		BOOST_REQUIRE_EQUAL(parallel.numberOfClusters(), k);
+		std::vector<std::size_t> clustersPlusPlus(k,0);
+		std::vector<std::size_t> clustersParallel(k,0);
+		for(std::size_t c = 0; c != k; ++c){
+			++clustersPlusPlus[(std::size_t)(plusPlus.centroids().element(c)(0) / 100.0)];
+			++clustersParallel[(std::size_t)(parallel.centroids().element(c)(0) / 100.0)];
+		}
+		for(std::size_t c = 0; c != k; ++c){
+			BOOST_CHECK_EQUAL(clustersPlusPlus[c], 1u);
+			BOOST_CHECK_EQUAL(clustersParallel[c], 1u);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(KMeans_MiniBatch)
+{
+	Rng::seed(42);
+	const std::size_t numPoints = 5000;
+	const std::size_t k = 4;
+	std::vector<RealVector> data(numPoints,RealVector(3));
+	for (std::size_t i=0; i<numPoints; i++){
+		for (std::size_t j=0; j <3; j++){
+			data[i](j) = Rng::gauss(0,0.1) + 10.0 * (i % k == j);
+		}
+	}
+	Data<RealVector> dataset = createDataFromRange(data,50);
+
+	Centroids centroids;
+	miniBatchKMeans(dataset, k, centroids, 200);
+	BOOST_REQUIRE_EQUAL(centroids.numberOfClusters(), k);
+	//every true mean has a close centroid
+	for(std::size_t c = 0; c != k; ++c){
+		RealVector mean(3,0.0);
+		if(c < 3) mean(c) = 10.0;
+		double closest = std::numeric_limits<double>::max();
+		for(std::size_t i = 0; i != k; ++i){
+			closest = std::min(closest, norm_2(centroids.centroids().element(i) - mean));
+		}
+		BOOST_CHECK_SMALL(closest, 0.05);
+	}
+}
+
+//initialization of an RBF layer
+BOOST_AUTO_TEST_CASE(KMeans_RBFLayer)
+{
+	Rng::seed(42);
+	std::vector<RealVector> data(300,RealVector(1));
+	for (std::size_t i=0; i<100; i++){
+		data[i](0) = Rng::uni();
+		data[100+i](0) = Rng::uni() + 10.0;
+		data[200+i](0) = Rng::uni() + 20.0;
+	}
+	Data<RealVector> dataset = createDataFromRange(data);
+	RBFLayer layer(1,3);
+	kMeans(dataset, layer);
+	std::vector<double> centers(3);
+	for(std::size_t c = 0; c != 3; ++c){
+		centers[c] = layer.centers()(c,0);
+	}
+	std::sort(centers.begin(),centers.end());
+	for(std::size_t c = 0; c != 3; ++c){
+		BOOST_CHECK_SMALL(centers[c] - (10.0 * c + 0.5), 0.2);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -58,4 +58,108 @@ BOOST_AUTO_TEST_CASE(LassoRegression_TEST)
 	}
 }
 
+
+//objective of the lasso problem for checking optimality
+double lassoObjective(LabeledData<RealVector, RealVector> const& data, RealVector const& w, double lambda){
+	double error = 0.0;
+	for(auto const& point: data.elements()){
+		double residual = inner_prod(w, point.input) - point.label(0);
+		error += 0.5 * residual * residual;
+	}
+	return error + lambda * norm_1(w);
+}
+
+//compares the regularization path to the solutions of single problems and
+//checks the optimality conditions of the path, in naive and in covariance mode
+BOOST_AUTO_TEST_CASE(LassoRegression_Path)
+{
+	Rng::seed(42);
+	std::size_t sizes[] = {50,400};//more features than points and vice versa
+	std::size_t dim = 100;
+	for(std::size_t size = 0; size != 2; ++size){
+		std::size_t n = sizes[size];
+		std::vector<RealVector> inputs(n, RealVector(dim));
+		std::vector<RealVector> labels(n, RealVector(1));
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != dim; ++j){
+				inputs[i](j) = Rng::gauss();
+			}
+			labels[i](0) = 3 * inputs[i](0) - 2 * inputs[i](7) + inputs[i](42) + 0.1 * Rng::gauss();
+		}
+		LabeledData<RealVector, RealVector> data = createLabeledDataFromRange(inputs, labels, 17);
+
+		double accuracy = 1.e-8;
+		LassoRegression<RealVector> trainer(1.0, accuracy);
+		RealVector lambdas = trainer.lambdaPath(data, 20, 1.e-2);
+		BOOST_REQUIRE_EQUAL(lambdas.size(), 20u);
+		RealMatrix path = trainer.trainPath(data, lambdas);
+		BOOST_REQUIRE_EQUAL(path.size1(), 20u);
+		BOOST_REQUIRE_EQUAL(path.size2(), dim);
+
+		//the first solution is zero
+		BOOST_CHECK_EQUAL(norm_inf(row(path,0)), 0.0);
+		//for small lambda the informative features are selected
+		BOOST_CHECK(std::abs(path(19,0)) > 1);
+		BOOST_CHECK(std::abs(path(19,7)) > 1);
+
+		//KKT conditions
+		RealMatrix X = createBatch(data.inputs().elements());
+		RealVector y = column(createBatch(data.labels().elements()),0);
+		for(std::size_t k = 0; k != lambdas.size(); ++k){
+			RealVector gradient = prod(trans(X), prod(X, row(path,k)) - y);
+			for(std::size_t j = 0; j != dim; ++j){
+				double w = path(k,j);
+				if(w == 0.0)
+					BOOST_CHECK(std::abs(gradient(j)) <= lambdas(k) + 10 * accuracy);
+				else
+					BOOST_CHECK_SMALL(gradient(j) + (w > 0? lambdas(k): -lambdas(k)), 10 * accuracy);
+			}
+		}
+
+		//the path agrees with training for a single lambda
+		for(std::size_t k = 5; k < lambdas.size(); k += 7){
+			trainer.setLambda(lambdas(k));
+			LinearModel<RealVector> model(dim);
+			trainer.train(model, data);
+			RealVector w = row(model.matrix(),0);
+			BOOST_CHECK_SMALL(
+				lassoObjective(data, w, lambdas(k)) - lassoObjective(data, row(path,k), lambdas(k)),
+				1.e-8
+			);
+			BOOST_CHECK_SMALL(norm_inf(w - row(path,k)), 1.e-6);
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(LassoRegression_Sparse)
+{
+	Rng::seed(42);
+	std::size_t n = 60;
+	std::size_t dim = 300;
+	std::vector<RealVector> inputs(n, RealVector(dim, 0.0));
+	std::vector<CompressedRealVector> sparseInputs(n, CompressedRealVector(dim));
+	std::vector<RealVector> labels(n, RealVector(1, 0.0));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t k = 0; k != 10; ++k){
+			std::size_t j = Rng::discrete(0, dim - 1);
+			double value = Rng::gauss();
+			inputs[i](j) = value;
+			sparseInputs[i](j) = value;
+		}
+		labels[i](0) = inputs[i](3) - inputs[i](5) + 0.1 * Rng::gauss();
+	}
+	LabeledData<RealVector, RealVector> data = createLabeledDataFromRange(inputs, labels, 16);
+	LabeledData<CompressedRealVector, RealVector> sparseData = createLabeledDataFromRange(sparseInputs, labels, 16);
+
+	LassoRegression<RealVector> trainer(1.0, 1.e-10);
+	LassoRegression<CompressedRealVector> sparseTrainer(1.0, 1.e-10);
+	RealVector lambdas = trainer.lambdaPath(data, 10, 1.e-2);
+	RealVector sparseLambdas = sparseTrainer.lambdaPath(sparseData, 10, 1.e-2);
+	BOOST_CHECK_SMALL(norm_inf(lambdas - sparseLambdas), 1.e-12);
+	RealMatrix path = trainer.trainPath(data, lambdas);
+	RealMatrix sparsePath = sparseTrainer.trainPath(sparseData, lambdas);
+	BOOST_CHECK_SMALL(max(abs(path - sparsePath)), 1.e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
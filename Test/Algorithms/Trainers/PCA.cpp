@@ -272,4 +272,107 @@ BOOST_AUTO_TEST_CASE( PCA_TEST_LESS_DATA_THAN_DIMENSIONS ){
 	}
 }
 
+
+///data in 40 dimensions with a quickly decaying spectrum,
+///which the approximate algorithms should reproduce.
+UnlabeledData<RealVector> createDataDecaying(std::size_t numberOfExamples, std::size_t dimensions)
+{
+	RealMatrix R(dimensions,dimensions);
+	for(std::size_t i = 0; i != dimensions; ++i){
+		for(std::size_t j = 0; j != dimensions; ++j){
+			R(i,j) = Rng::gauss() * std::pow(0.7,double(i));
+		}
+	}
+	std::vector<RealVector> data(numberOfExamples,RealVector(dimensions));
+	for(auto& sample: data){
+		RealVector z(dimensions);
+		for(std::size_t j = 0; j != dimensions; ++j){
+			z(j) = Rng::gauss();
+		}
+		noalias(sample) = prod(z,R);
+		sample(0) += 5;
+	}
+	return createDataFromRange(data,100);
+}
+
+//compares the first k eigenvalues of two PCAs relative to the largest eigenvalue and
+//the eigenvectors up to sign, as long as they are well determined
+void checkComponents(PCA const& pca, PCA const& reference, std::size_t k, double tolerance){
+	BOOST_REQUIRE(pca.eigenvalues().size() >= k);
+	BOOST_CHECK_SMALL(norm_inf(pca.mean() - reference.mean()), 1.e-10);
+	double scale = reference.eigenvalue(0);
+	for(std::size_t i = 0; i != k; ++i){
+		BOOST_CHECK_SMALL((pca.eigenvalue(i) - reference.eigenvalue(i))/scale, tolerance);
+		if(reference.eigenvalue(i) < 1.e-3 * scale) continue;
+		double overlap = inner_prod(column(pca.eigenvectors(),i),column(reference.eigenvectors(),i));
+		BOOST_CHECK_SMALL(std::abs(overlap) - 1.0, tolerance);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( PCA_TEST_RANDOMIZED ){
+	Rng::seed(42);
+	UnlabeledData<RealVector> data = createDataDecaying(2000,40);
+	PCA reference(data);
+
+	PCA pca;
+	pca.setAlgorithm(PCA::RANDOMIZED);
+	pca.setNumberOfComponents(5);
+	pca.setData(data);
+	BOOST_REQUIRE_EQUAL(pca.eigenvalues().size(), 5u);
+	BOOST_REQUIRE_EQUAL(pca.eigenvectors().size1(), 40u);
+	BOOST_REQUIRE_EQUAL(pca.eigenvectors().size2(), 5u);
+	checkComponents(pca, reference, 5, 1.e-6);
+
+	//train uses the output size of the model as number of components
+	PCA trainer;
+	trainer.setAlgorithm(PCA::RANDOMIZED);
+	LinearModel<> model(40,3,true);
+	trainer.train(model,data);
+	BOOST_CHECK_EQUAL(trainer.eigenvalues().size(), 3u);
+	LinearModel<> referenceModel;
+	reference.encoder(referenceModel,3);
+	Data<RealVector> encoded = model(data);
+	Data<RealVector> referenceEncoded = referenceModel(data);
+	for(std::size_t b = 0; b != encoded.numberOfBatches(); ++b){
+		BOOST_CHECK_SMALL(max(abs(abs(encoded.batch(b)) - abs(referenceEncoded.batch(b)))), 1.e-4);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( PCA_TEST_INCREMENTAL ){
+	Rng::seed(42);
+	UnlabeledData<RealVector> data = createDataDecaying(2000,40);
+	PCA reference(data);
+
+	//keeping all components, the incremental update is exact
+	PCA pca;
+	pca.updateData(data);
+	BOOST_CHECK_EQUAL(pca.eigenvalues().size(), 40u);
+	checkComponents(pca, reference, 40, 1.e-8);
+
+	//truncated: the data seen later is added to the leading components
+	PCA truncated;
+	truncated.setNumberOfComponents(10);
+	truncated.updateData(data);
+	BOOST_CHECK_EQUAL(truncated.eigenvalues().size(), 10u);
+	checkComponents(truncated, reference, 3, 1.e-3);
+
+	//updating a decomposition from setData with new data gives the decomposition of all data
+	std::vector<RealVector> points(data.elements().begin(),data.elements().end());
+	UnlabeledData<RealVector> first = createDataFromRange(std::vector<RealVector>(points.begin(),points.begin()+500),100);
+	UnlabeledData<RealVector> second = createDataFromRange(std::vector<RealVector>(points.begin()+500,points.end()),100);
+	PCA combined(first);
+	combined.updateData(second);
+	checkComponents(combined, reference, 40, 1.e-8);
+
+	//more dimensions than points in a batch and in total
+	UnlabeledData<RealVector> small = createDataNotFullRank();
+	PCA smallReference(small);
+	PCA smallPCA;
+	smallPCA.updateData(small);
+	checkComponents(smallPCA, smallReference, 4, 1.e-8);
+	LinearModel<> enc;
+	smallPCA.encoder(enc);
+	BOOST_CHECK_EQUAL(enc.outputSize(), 5u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -73,4 +73,100 @@ BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_TEST )
 	}
 }
 
+//with full rank the low-rank trainer must reproduce the exact solution,
+//with a smaller rank the predictions must still be reasonable
+BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_LOW_RANK )
+{
+	const std::size_t ell = 100;
+	Wave prob(0.0, 5.0);
+	RegressionDataset training = prob.generateDataset(ell);
+
+	GaussianRbfKernel<> kernel(0.5);
+	RegularizationNetworkTrainer<RealVector> trainer(&kernel, 0.1);
+	KernelExpansion<RealVector> exact;
+	trainer.train(exact, training);
+	RealMatrix exactOutput = exact(createBatch<RealVector>(training.inputs().elements()));
+
+	trainer.setLowRankApproximation(ell,0.0);
+	BOOST_CHECK_EQUAL(trainer.lowRankApproximation(), ell);
+	KernelExpansion<RealVector> full;
+	trainer.train(full, training);
+	//the decomposition stops early at the numerical rank of the kernel matrix
+	BOOST_CHECK(full.basis().numberOfElements() <= ell);
+	RealMatrix fullOutput = full(createBatch<RealVector>(training.inputs().elements()));
+	BOOST_CHECK_SMALL(norm_inf(column(fullOutput - exactOutput,0)), 1.e-6);
+
+	trainer.setLowRankApproximation(20);
+	KernelExpansion<RealVector> lowRank;
+	trainer.train(lowRank, training);
+	BOOST_CHECK_EQUAL(lowRank.basis().numberOfElements(), 20);
+	RealMatrix lowRankOutput = lowRank(createBatch<RealVector>(training.inputs().elements()));
+	BOOST_CHECK_SMALL(norm_inf(column(lowRankOutput - exactOutput,0)), 1.e-2);
+}
+
+//the incomplete Cholesky factor must interpolate the kernel matrix at the pivots
+BOOST_AUTO_TEST_CASE( INCOMPLETE_CHOLESKY_FACTOR )
+{
+	Wave prob(0.0, 5.0);
+	RegressionDataset training = prob.generateDataset(60);
+	GaussianRbfKernel<> kernel(0.5);
+	RealMatrix K = calculateRegularizedKernelMatrix(kernel,training.inputs());
+
+	RealMatrix L;
+	std::vector<std::size_t> pivots = calculateIncompleteCholeskyFactor(kernel,training.inputs(),L,10);
+	BOOST_REQUIRE_EQUAL(pivots.size(), 10);
+	BOOST_REQUIRE_EQUAL(L.size2(), 10);
+	RealMatrix approx = prod(L,trans(L));
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t k = i+1; k != 10; ++k)
+			BOOST_CHECK_EQUAL(L(pivots[i],k), 0.0);
+		for(std::size_t j = 0; j != 60; ++j)
+			BOOST_CHECK_SMALL(approx(pivots[i],j) - K(pivots[i],j), 1.e-10);
+	}
+	//the approximation error is bounded by the trace of the residual
+	double residual = trace(K) - trace(approx);
+	BOOST_CHECK(residual >= 0);
+	for(std::size_t i = 0; i != 60; ++i)
+		BOOST_CHECK(K(i,i) - approx(i,i) <= residual + 1.e-12);
+
+	//with a tolerance the decomposition stops at the numerical rank
+	pivots = calculateIncompleteCholeskyFactor(kernel,training.inputs(),L,60,1.e-4);
+	BOOST_CHECK(pivots.size() < 60);
+	BOOST_CHECK_EQUAL(L.size2(), pivots.size());
+	RealMatrix error = K - prod(L,trans(L));
+	BOOST_CHECK_SMALL(norm_inf(diag(error)), 1.e-4);
+}
+
+//the iterative solver must reproduce the exact solution, also for multiple outputs
+BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_ITERATIVE )
+{
+	Wave prob(0.0, 5.0);
+	RegressionDataset training = prob.generateDataset(300);
+	std::vector<RealVector> inputs(training.inputs().elements().begin(),training.inputs().elements().end());
+	std::vector<RealVector> labels(300,RealVector(2));
+	for(std::size_t i = 0; i != 300; ++i){
+		labels[i](0) = training.labels().element(i)(0);
+		labels[i](1) = std::cos(inputs[i](0));
+	}
+	RegressionDataset data = createLabeledDataFromRange(inputs,labels,50);
+
+	GaussianRbfKernel<> kernel(0.5);
+	RegularizationNetworkTrainer<RealVector> trainer(&kernel, 0.01);
+	KernelExpansion<RealVector> exact;
+	trainer.train(exact, data);
+	RealMatrix exactOutput = exact(createBatch<RealVector>(inputs));
+
+	std::size_t ranks[] = {0, 20};
+	for(std::size_t r = 0; r != 2; ++r){
+		trainer.setIterativeSolver(ranks[r], 1.e-10);
+		KernelExpansion<RealVector> iterative;
+		trainer.train(iterative, data);
+		BOOST_REQUIRE_EQUAL(iterative.outputSize(), 2);
+		RealMatrix output = iterative(createBatch<RealVector>(inputs));
+		BOOST_CHECK_SMALL(norm_inf(column(output - exactOutput,0)), 1.e-6);
+		for(std::size_t i = 0; i != 300; ++i)
+			BOOST_CHECK_SMALL(output(i,1) - std::cos(inputs[i](0)), 0.05);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -36,6 +36,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <algorithm>
+#include <sstream>
 
 #include <shark/LinAlg/Base.h>
 #include <shark/Models/Kernels/LinearKernel.h>
@@ -43,6 +44,10 @@
 #include <shark/Models/Trees/LCTree.h>
 #include <shark/Models/Trees/KHCTree.h>
 #include <shark/Algorithms/NearestNeighbors/TreeNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/FlatTreeNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/HNSWNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/SimpleNearestNeighbors.h>
+#include <shark/Models/Trees/FlatKDTree.h>
 #include <shark/Rng/GlobalRng.h>
 #include <shark/Core/Timer.h>
 
@@ -201,4 +206,187 @@ BOOST_AUTO_TEST_CASE(IterativeNearestNeighborQueries)
 	}
 }
 
+//the brute force search splits the queries in blocks and uses different strategies to update the heaps,
+//depending on the number of neighbors. Check all cases against sorting the distances.
+BOOST_AUTO_TEST_CASE(SimpleNearestNeighbors_Blocks)
+{
+	Rng::seed(42);
+	std::size_t numPoints = 1000;
+	std::size_t numQueries = 300;
+	std::vector<RealVector> data(numPoints,RealVector(3));
+	std::vector<unsigned int> labels(numPoints);
+	for (std::size_t i=0; i != numPoints; i++){
+		for(std::size_t j = 0; j != 3; ++j)
+			data[i](j) = Rng::gauss();
+		labels[i] = (unsigned int)i;
+	}
+	RealMatrix queries(numQueries,3);
+	for (std::size_t i=0; i != numQueries; i++){
+		for(std::size_t j = 0; j != 3; ++j)
+			queries(i,j) = Rng::gauss();
+	}
+	LabeledData<RealVector,unsigned int> dataset = createLabeledDataFromRange(data,labels,64);
+	LinearKernel<RealVector> kernel;
+	SimpleNearestNeighbors<RealVector,unsigned int> simple(dataset,&kernel);
+
+	std::size_t ks[] = {1,5,100,1000};
+	for(std::size_t t = 0; t != 4; ++t){
+		std::size_t k = ks[t];
+		std::vector<KeyValuePair<double,unsigned int> > neighbors = simple.getNeighbors(queries,k);
+		BOOST_REQUIRE_EQUAL(neighbors.size(), numQueries*k);
+		for(std::size_t q = 0; q != numQueries; ++q){
+			std::vector<KeyValuePair<double,unsigned int> > reference(numPoints);
+			for(std::size_t i = 0; i != numPoints; ++i){
+				reference[i].key = distanceSqr(row(queries,q),data[i]);
+				reference[i].value = labels[i];
+			}
+			std::sort(reference.begin(),reference.end());
+			for(std::size_t i = 0; i != k; ++i){
+				BOOST_CHECK_SMALL(neighbors[q*k+i].key - reference[i].key, 1.e-10);
+				BOOST_CHECK_EQUAL(neighbors[q*k+i].value, reference[i].value);
+			}
+		}
+	}
+}
+
+//compare the batched queries of the FlatKDTree with brute force search
+BOOST_AUTO_TEST_CASE(FlatKDTree_BatchedQueries)
+{
+	Rng::seed(42);
+	std::size_t numPoints = 2000;
+	std::size_t numQueries = 50;
+	std::size_t k = 10;
+	std::vector<RealVector> data(numPoints,RealVector(4));
+	std::vector<unsigned int> labels(numPoints);
+	for (std::size_t i=0; i != numPoints; i++){
+		for(std::size_t j = 0; j != 4; ++j)
+			data[i](j) = Rng::gauss();
+		labels[i] = (unsigned int)i;
+	}
+	RealMatrix queries(numQueries,4);
+	for (std::size_t i=0; i != numQueries; i++){
+		for(std::size_t j = 0; j != 4; ++j)
+			queries(i,j) = Rng::gauss();
+	}
+	//some queries hit a point exactly
+	row(queries,0) = data[17];
+	row(queries,1) = data[1999];
+	LabeledData<RealVector,unsigned int> dataset = createLabeledDataFromRange(data,labels,100);
+
+	LinearKernel<RealVector> kernel;
+	SimpleNearestNeighbors<RealVector,unsigned int> simple(dataset,&kernel);
+	std::vector<KeyValuePair<double,unsigned int> > reference = simple.getNeighbors(queries,k);
+
+	std::size_t bucketSizes[] = {1,7,32,5000};
+	for(std::size_t b = 0; b != 4; ++b){
+		FlatKDTree tree(dataset.inputs(),bucketSizes[b]);
+		BOOST_REQUIRE_EQUAL(tree.size(), numPoints);
+		//the reordered points are the points of the dataset
+		for(std::size_t i = 0; i != numPoints; ++i){
+			BOOST_CHECK_SMALL(norm_inf(row(tree.points(),i) - data[tree.index(i)]), 1.e-15);
+		}
+		//the bounding box of the root contains all points
+		for(std::size_t i = 0; i != numPoints; ++i){
+			for(std::size_t j = 0; j != 4; ++j){
+				BOOST_CHECK(tree.lower()(0,j) <= data[i](j));
+				BOOST_CHECK(tree.upper()(0,j) >= data[i](j));
+			}
+		}
+		FlatTreeNearestNeighbors<RealVector,unsigned int> flat(dataset,&tree);
+		std::vector<KeyValuePair<double,unsigned int> > neighbors = flat.getNeighbors(queries,k);
+		BOOST_REQUIRE_EQUAL(neighbors.size(), numQueries*k);
+		for(std::size_t i = 0; i != numQueries*k; ++i){
+			//SimpleNearestNeighbors returns squared distances
+			BOOST_CHECK_SMALL(neighbors[i].key - std::sqrt(reference[i].key), 1.e-12);
+			BOOST_CHECK_EQUAL(neighbors[i].value, reference[i].value);
+		}
+		BOOST_CHECK_EQUAL(neighbors[0].value, 17u);
+		BOOST_CHECK_EQUAL(neighbors[k].value, 1999u);
+		BOOST_CHECK_SMALL(neighbors[0].key, 1.e-15);
+	}
+}
+
+//the approximate neighbors of the HNSW graph are compared with brute force search in a higher dimensional space
+BOOST_AUTO_TEST_CASE(HNSW_Recall)
+{
+	Rng::seed(42);
+	std::size_t numPoints = 3000;
+	std::size_t numQueries = 100;
+	std::size_t dim = 20;
+	std::size_t k = 10;
+	std::vector<RealVector> data(numPoints,RealVector(dim));
+	std::vector<unsigned int> labels(numPoints);
+	for (std::size_t i=0; i != numPoints; i++){
+		for(std::size_t j = 0; j != dim; ++j)
+			data[i](j) = Rng::gauss();
+		labels[i] = (unsigned int)i;
+	}
+	RealMatrix queries(numQueries,dim);
+	for (std::size_t i=0; i != numQueries; i++){
+		for(std::size_t j = 0; j != dim; ++j)
+			queries(i,j) = Rng::gauss();
+	}
+	LabeledData<RealVector,unsigned int> dataset = createLabeledDataFromRange(data,labels,100);
+
+	LinearKernel<RealVector> kernel;
+	SimpleNearestNeighbors<RealVector,unsigned int> simple(dataset,&kernel);
+	std::vector<KeyValuePair<double,unsigned int> > reference = simple.getNeighbors(queries,k);
+
+	HNSWGraph graph(dataset.inputs(),16,100);
+	BOOST_REQUIRE_EQUAL(graph.size(), numPoints);
+	//no point has more neighbors than allowed
+	for(std::size_t i = 0; i != numPoints; ++i){
+		BOOST_CHECK_LE(graph.neighbors(i,0).size(), 32u);
+		for(std::size_t l = 1; l <= graph.level(i); ++l){
+			BOOST_CHECK_LE(graph.neighbors(i,l).size(), 16u);
+		}
+	}
+
+	HNSWNearestNeighbors<RealVector,unsigned int> hnsw(dataset,&graph);
+	double previousRecall = 0;
+	std::size_t efs[] = {10,50,200};
+	for(std::size_t e = 0; e != 3; ++e){
+		hnsw.setEf(efs[e]);
+		std::vector<KeyValuePair<double,unsigned int> > neighbors = hnsw.getNeighbors(queries,k);
+		BOOST_REQUIRE_EQUAL(neighbors.size(), numQueries*k);
+		std::size_t hits = 0;
+		for(std::size_t q = 0; q != numQueries; ++q){
+			for(std::size_t i = 0; i != k; ++i){
+				//the reported distances are the true distances and sorted
+				unsigned int label = neighbors[q*k+i].value;
+				BOOST_CHECK_SMALL(neighbors[q*k+i].key - norm_2(row(queries,q) - data[label]), 1.e-10);
+				if(i > 0)
+					BOOST_CHECK_LE(neighbors[q*k+i-1].key, neighbors[q*k+i].key);
+				for(std::size_t j = 0; j != k; ++j){
+					if(reference[q*k+j].value == label) ++hits;
+				}
+			}
+		}
+		double recall = double(hits)/(numQueries*k);
+		BOOST_TEST_MESSAGE("ef "<<efs[e]<<" recall@10: "<<recall);
+		BOOST_CHECK_GE(recall, previousRecall - 0.01);
+		previousRecall = recall;
+	}
+	BOOST_CHECK_GE(previousRecall, 0.95);
+
+	//a serialized and restored graph gives the same results
+	std::ostringstream outputStream;
+	{
+		TextOutArchive oa(outputStream);
+		oa << graph;
+	}
+	HNSWGraph restored;
+	std::istringstream inputStream(outputStream.str());
+	TextInArchive ia(inputStream);
+	ia >> restored;
+	BOOST_REQUIRE_EQUAL(restored.size(), numPoints);
+	BOOST_REQUIRE_EQUAL(restored.numberOfLayers(), graph.numberOfLayers());
+	std::vector<KeyValuePair<double,std::size_t> > original = graph.kNearest(queries,k,50);
+	std::vector<KeyValuePair<double,std::size_t> > fromArchive = restored.kNearest(queries,k,50);
+	for(std::size_t i = 0; i != numQueries*k; ++i){
+		BOOST_CHECK_EQUAL(original[i].value, fromArchive[i].value);
+		BOOST_CHECK_EQUAL(original[i].key, fromArchive[i].key);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -118,4 +118,28 @@ BOOST_AUTO_TEST_CASE( Data_Statistics_meanvar_covariance )
 }
 
 
+BOOST_AUTO_TEST_CASE( Data_Statistics_scatterMatrix )
+{
+	//scatter of the inputs concatenated with a column of ones
+	RealMatrix scatter;
+	scatterMatrix(inputDataSmallBatch,[](RealMatrix const& batch) -> RealMatrix{
+		RealMatrix result(batch.size1(),batch.size2()+1,1.0);
+		noalias(columns(result,0,batch.size2())) = batch;
+		return result;
+	},scatter);
+	BOOST_REQUIRE_EQUAL(scatter.size1(), Dimensions+1);
+	BOOST_REQUIRE_EQUAL(scatter.size2(), Dimensions+1);
+	double n = inputData.numberOfElements();
+	BOOST_CHECK_SMALL(scatter(Dimensions,Dimensions) - n,1.e-12);
+	for(std::size_t i=0;i!=Dimensions;++i){
+		BOOST_CHECK_SMALL(scatter(i,Dimensions) - n * resultMean[i],1.e-5);
+		BOOST_CHECK_SMALL(scatter(Dimensions,i) - n * resultMean[i],1.e-5);
+		for(std::size_t j=0; j != Dimensions; ++j){
+			double secondMoment = resultVariance[i][j] + resultMean[i] * resultMean[j];
+			BOOST_CHECK_SMALL(scatter(i,j) - n * secondMoment,1.e-4);
+		}
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -4,6 +4,7 @@
 
 #include <shark/LinAlg/BLAS/blas.h>
 #include <shark/LinAlg/BLAS/triangular_matrix.hpp>
+#include <cmath>
 
 using namespace shark;
 
@@ -764,4 +765,78 @@ BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Sparse_Sparse_Matrix_Plus_Assign ){
 		checkMatrixEqual(target,result);
 	}
 }
+//the fused kernel for dense row-major expressions must give the same results as the elementwise definition,
+//also when an argument is column-major and the generic kernel is used.
+//the large size is processed in parallel when OpenMP is used.
+BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Dense_Matrix_Assign_Fused ){
+	std::size_t sizes1[] = {1, 7, 400};
+	std::size_t sizes2[] = {1000, 13, 300};
+	for(std::size_t s = 0; s != 3; ++s){
+		std::size_t n = sizes1[s];
+		std::size_t m = sizes2[s];
+		blas::matrix<double> A(n,m);
+		blas::matrix<double> B(n,m);
+		blas::matrix<double,blas::column_major> C(n,m);
+		blas::vector<double> bias(m);
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != m; ++j){
+				A(i,j) = std::sin(0.1*i + 0.01*j);
+				B(i,j) = std::cos(0.3*i - 0.02*j);
+				C(i,j) = 0.5*i + j;
+			}
+		}
+		for(std::size_t j = 0; j != m; ++j){
+			bias(j) = 1.0/(j+1);
+		}
+		//row-major
+		{
+			blas::matrix<double> R(n,m);
+			noalias(R) = tanh(A) * B + repeat(bias,n);
+			for(std::size_t i = 0; i != n; ++i){
+				for(std::size_t j = 0; j != m; ++j){
+					BOOST_CHECK_SMALL(R(i,j) - (std::tanh(A(i,j)) * B(i,j) + bias(j)), 1.e-12);
+				}
+			}
+			noalias(R) -= 0.5 * (A - B);
+			for(std::size_t i = 0; i != n; ++i){
+				for(std::size_t j = 0; j != m; ++j){
+					double expected = std::tanh(A(i,j)) * B(i,j) + bias(j) - 0.5 * (A(i,j) - B(i,j));
+					BOOST_CHECK_SMALL(R(i,j) - expected, 1.e-12);
+				}
+			}
+		}
+		//sub-matrices with leading dimension bigger than the number of columns
+		if(m > 2){
+			blas::matrix<double> R(n,m,1.0);
+			noalias(columns(R,1,m)) += columns(A,0,m-1) * columns(B,1,m);
+			for(std::size_t i = 0; i != n; ++i){
+				BOOST_CHECK_EQUAL(R(i,0), 1.0);
+				for(std::size_t j = 1; j != m; ++j){
+					BOOST_CHECK_SMALL(R(i,j) - (1.0 + A(i,j-1) * B(i,j)), 1.e-12);
+				}
+			}
+		}
+		//column-major argument
+		{
+			blas::matrix<double> R(n,m);
+			noalias(R) = A + C;
+			for(std::size_t i = 0; i != n; ++i){
+				for(std::size_t j = 0; j != m; ++j){
+					BOOST_CHECK_SMALL(R(i,j) - (A(i,j) + C(i,j)), 1.e-12);
+				}
+			}
+		}
+		//column-major target
+		{
+			blas::matrix<double,blas::column_major> R(n,m);
+			noalias(R) = 2.0 * A;
+			for(std::size_t i = 0; i != n; ++i){
+				for(std::size_t j = 0; j != m; ++j){
+					BOOST_CHECK_EQUAL(R(i,j), 2.0 * A(i,j));
+				}
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include <shark/LinAlg/BLAS/blas.h>
 #include <shark/LinAlg/BLAS/triangular_matrix.hpp>
+#include <shark/LinAlg/BLAS/kernels/syrk.hpp>
 
 using namespace shark;
 using namespace blas;
@@ -918,4 +919,42 @@ BOOST_AUTO_TEST_CASE( BLAS_prod_matrix_vector_triangular ){
 	}
 }
 
+//sizes which are not multiples of the block size of the default kernel
+BOOST_AUTO_TEST_CASE( BLAS_prod_syrk ){
+	std::size_t dims = 139;
+	std::size_t k = 71;
+	matrix<double,row_major> A(dims,k);
+	matrix<double,column_major> AColumn(dims,k);
+	for(std::size_t i = 0; i != dims; ++i){
+		for(std::size_t j = 0; j != k; ++j){
+			A(i,j) = AColumn(i,j) = 0.1*i - 0.2*j + ((i*j) % 7);
+		}
+	}
+	matrix<double> result = prod(A,trans(A));
+	for(std::size_t upper = 0; upper != 2; ++upper){
+		matrix<double,row_major> C(dims,dims,1.0);
+		matrix<double,column_major> CColumn(dims,dims,1.0);
+		matrix<double,row_major> CDefault(dims,dims,1.0);
+		if(upper){
+			kernels::syrk<true>(A,C,2.0);
+			kernels::syrk<true>(A,CColumn,2.0);
+			bindings::syrk<true>(AColumn,CDefault,2.0,boost::mpl::false_());
+		}else{
+			kernels::syrk<false>(A,C,2.0);
+			kernels::syrk<false>(A,CColumn,2.0);
+			bindings::syrk<false>(AColumn,CDefault,2.0,boost::mpl::false_());
+		}
+		for(std::size_t i = 0; i != dims; ++i){
+			for(std::size_t j = 0; j != dims; ++j){
+				//the other triangle is not touched
+				bool inTriangle = upper? j >= i : j <= i;
+				double expected = inTriangle? 1.0 + 2 * result(i,j) : 1.0;
+				BOOST_CHECK_CLOSE(C(i,j), expected, 1.e-10);
+				BOOST_CHECK_CLOSE(CColumn(i,j), expected, 1.e-10);
+				BOOST_CHECK_CLOSE(CDefault(i,j), expected, 1.e-10);
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
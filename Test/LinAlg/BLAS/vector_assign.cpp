@@ -3,6 +3,7 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <shark/LinAlg/BLAS/blas.h>
+#include <cmath>
 
 using namespace shark;
 
@@ -140,4 +141,78 @@ BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Vector_Assign_Functor ){
 }
 
 
+//the fused kernel for dense expressions must give the same results as the elementwise definition,
+//also when a part of the expression is not contiguous in memory and the generic kernel is used.
+//the large size is processed in parallel chunks when OpenMP is used.
+BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Vector_Assign_Fused ){
+	std::size_t sizes[] = {15, 1000, 100000};
+	for(std::size_t s = 0; s != 3; ++s){
+		std::size_t n = sizes[s];
+		blas::vector<double> a(n);
+		blas::vector<double> b(n);
+		blas::matrix<double> M(n,3);
+		for(std::size_t i = 0; i != n; ++i){
+			a(i) = std::sin(0.1*i);
+			b(i) = std::cos(0.3*i);
+			M(i,0) = 1.0/(i+1);
+			M(i,1) = std::sin(0.2*i);
+			M(i,2) = 0.5*i;
+		}
+		//contiguous
+		{
+			blas::vector<double> r(n,1.0);
+			noalias(r) = exp(a + b) - 2.0 * a * b;
+			for(std::size_t i = 0; i != n; ++i){
+				BOOST_CHECK_SMALL(r(i) - (std::exp(a(i) + b(i)) - 2.0 * a(i) * b(i)), 1.e-12);
+			}
+			noalias(r) += safe_div(a, b, 0.0) + blas::repeat(3.0,n);
+			for(std::size_t i = 0; i != n; ++i){
+				double expected = std::exp(a(i) + b(i)) - 2.0 * a(i) * b(i) + a(i) / b(i) + 3.0;
+				BOOST_CHECK_SMALL(r(i) - expected, 1.e-10 * std::max(1.0, std::abs(expected)));
+			}
+		}
+		//subrange target and arguments
+		{
+			blas::vector<double> r(n,1.0);
+			noalias(subrange(r,1,n)) -= subrange(a,0,n-1) * subrange(b,1,n);
+			BOOST_CHECK_EQUAL(r(0), 1.0);
+			for(std::size_t i = 1; i != n; ++i){
+				BOOST_CHECK_SMALL(r(i) - (1.0 - a(i-1) * b(i)), 1.e-12);
+			}
+		}
+		//strided arguments
+		{
+			blas::vector<double> r(n);
+			noalias(r) = a + column(M,1);
+			for(std::size_t i = 0; i != n; ++i){
+				BOOST_CHECK_SMALL(r(i) - (a(i) + M(i,1)), 1.e-12);
+			}
+		}
+		//strided target
+		{
+			blas::matrix<double> R = M;
+			noalias(column(R,2)) *= 2.0 * a;
+			for(std::size_t i = 0; i != n; ++i){
+				BOOST_CHECK_SMALL(R(i,2) - 2.0 * a(i) * M(i,2), 1.e-12);
+				BOOST_CHECK_EQUAL(R(i,1), M(i,1));
+			}
+		}
+		//diagonal of a matrix
+		{
+			blas::matrix<double> D(3,4,0.0);
+			blas::vector<double> d(3);
+			d(0) = 1; d(1) = 2; d(2) = 3;
+			noalias(diag(subrange(D,0,3,1,4))) = d;
+			for(std::size_t i = 0; i != 3; ++i){
+				for(std::size_t j = 0; j != 4; ++j){
+					BOOST_CHECK_EQUAL(D(i,j), j == i+1 ? d(i) : 0.0);
+				}
+			}
+			blas::vector<double> r = diag(subrange(D,0,3,1,4));
+			checkVectorEqual(r,d);
+		}
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,8 @@
 #include <shark/LinAlg/BlockMatrix2x2.h>
 #include <shark/LinAlg/CachedMatrix.h>
 #include <shark/LinAlg/KernelMatrix.h>
+#include <shark/LinAlg/KernelMatrixOperator.h>
+#include <shark/LinAlg/solveSystem.h>
 #include <shark/LinAlg/ModifiedKernelMatrix.h>
 #include <shark/LinAlg/PrecomputedMatrix.h>
 #include <shark/LinAlg/RegularizedKernelMatrix.h>
@@ -227,4 +229,34 @@ BOOST_AUTO_TEST_CASE( QP_CachedMatrix_Flipping ) {
 }
 
 
+BOOST_FIXTURE_TEST_CASE( LinAlg_KernelMatrixOperator, Fixture )
+{
+	RealMatrix V(size,3);
+	for(std::size_t i = 0; i != size; ++i)
+		for(std::size_t j = 0; j != 3; ++j)
+			V(i,j) = Rng::gauss(0,1);
+	KernelMatrixOperator<RealVector> K(kernel,data.inputs(),0.5);
+	BOOST_REQUIRE_EQUAL(K.size(), size);
+	RealMatrix KV;
+	K(V,KV);
+	RealMatrix regularized = kernelMatrix;
+	for(std::size_t i = 0; i != size; ++i)
+		regularized(i,i) += 0.5;
+	RealMatrix result = prod(regularized,V);
+	BOOST_CHECK_SMALL(norm_inf(KV-result), 1.e-12);
+
+	//the linear kernel on 5 dimensional data has rank 5, so the preconditioner is the exact inverse
+	PivotedCholeskyPreconditioner<RealVector> preconditioner(kernel,data.inputs(),0.5,10);
+	BOOST_CHECK_EQUAL(preconditioner.rank(), 5);
+	RealMatrix Z;
+	preconditioner(result,Z);
+	BOOST_CHECK_SMALL(norm_inf(Z-V), 1.e-10);
+
+	//thus the preconditioned conjugate gradient converges in a single step
+	RealMatrix X;
+	std::size_t iterations = blas::conjugateGradient(K,preconditioner,X,result,1.e-10);
+	BOOST_CHECK(iterations <= 2);
+	BOOST_CHECK_SMALL(norm_inf(X-V), 1.e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
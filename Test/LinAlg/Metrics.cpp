@@ -277,4 +277,39 @@ BOOST_AUTO_TEST_CASE( LinAlg_Norm_distanceSqr_Matrix_Matrix){
 
 
 
+//the result can be stored in a sub-range of a larger matrix, float is supported
+//and identical points have distance zero despite cancellation
+BOOST_AUTO_TEST_CASE( LinAlg_Norm_distanceSqr_Matrix_Matrix_Range){
+	FloatMatrix mat1(32,5);
+	FloatMatrix mat2(20,5);
+	for(std::size_t i = 0; i != 32; ++i){
+		for(std::size_t k = 0; k != 5; ++k){
+			mat1(i,k) = 1000.0f + 0.1f*((i * 7 + k * 3) % 11);
+		}
+	}
+	for(std::size_t j = 0; j != 20; ++j){
+		noalias(row(mat2,j)) = row(mat1,j);
+	}
+	
+	FloatMatrix result(32,30,-1.0f);
+	auto block = columns(result,5,25);
+	distanceSqr(mat1,mat2,block);
+	for(std::size_t i = 0; i != 32; ++i){
+		for(std::size_t j = 0; j != 30; ++j){
+			if(j < 5 || j >= 25){
+				BOOST_CHECK_EQUAL(result(i,j),-1.0f);
+				continue;
+			}
+			double d = 0;
+			for(std::size_t k = 0; k != 5; ++k){
+				double diff = double(mat1(i,k)) - double(mat2(j-5,k));
+				d += diff*diff;
+			}
+			BOOST_CHECK(result(i,j) >= 0.0f);
+			BOOST_CHECK_SMALL(result(i,j) - d, 2.0);
+		}
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
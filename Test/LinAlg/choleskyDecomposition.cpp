@@ -135,6 +135,48 @@ BOOST_AUTO_TEST_CASE( LinAlg_CholeskyDecomposition ){
 	}
 }
 
+//matrices larger than the block size of the blocked factorization
+BOOST_AUTO_TEST_CASE( LinAlg_CholeskyDecomposition_Blocked ){
+	std::size_t Dimensions = 203;
+	RealVector lambda(Dimensions);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		lambda(i) = Rng::uni(1,3.0);
+	}
+	RealMatrix A = createRandomMatrix(lambda,Dimensions);
+	
+	//row major lower
+	RealMatrix C(Dimensions,Dimensions);
+	choleskyDecomposition(A,C);
+	BOOST_CHECK_SMALL(norm_inf(A-prod(C,trans(C))),1.e-12);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		for(std::size_t j = i+1; j != Dimensions; ++j){
+			BOOST_CHECK_EQUAL(C(i,j),0.0);
+		}
+	}
+	
+	//column major lower
+	blas::matrix<double, blas::column_major> CColumn(Dimensions,Dimensions);
+	choleskyDecomposition(A,CColumn);
+	BOOST_CHECK_SMALL(norm_inf(C-CColumn),1.e-12);
+	
+	//row major upper, the upper factor is the transpose of the lower factor
+	RealMatrix U = A;
+	BOOST_REQUIRE_EQUAL(blas::kernels::potrf<blas::upper>(U), 0u);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		for(std::size_t j = i; j != Dimensions; ++j){
+			BOOST_CHECK_SMALL(U(i,j)-C(j,i),1.e-12);
+		}
+	}
+	
+	//an indefinite matrix is detected in a later block
+	RealMatrix B = A;
+	B(150,150) = -1;
+	std::size_t info = blas::kernels::potrf<blas::lower>(B);
+	BOOST_CHECK(info != 0);
+	BOOST_CHECK(info <= 151);
+	BOOST_CHECK_THROW(choleskyDecomposition(B,C), Exception);
+}
+
 BOOST_AUTO_TEST_CASE( LinAlg_PivotingCholeskyDecomposition_FullRank ){
 	std::size_t NumTests = 100;
 	std::size_t Dimensions = 48;
@@ -95,4 +95,71 @@ BOOST_AUTO_TEST_CASE( LinAlg_eigensymm_general )
 		BOOST_CHECK_SMALL(error_orthogonalize,1.e-12);
 	}
 }
+
+//large enough to use the blocked tridiagonalization and the divide and conquer steps,
+//with clusters of repeated eigenvalues which trigger deflation
+BOOST_AUTO_TEST_CASE( LinAlg_eigensymm_large )
+{
+	std::size_t Dimensions = 203;
+	for(std::size_t test = 0; test != 3; ++test){
+		RealVector lambda(Dimensions);
+		for(std::size_t i = 0; i != Dimensions; ++i){
+			if(test == 0)
+				lambda(i) = Rng::uni(1,3.0);
+			else if(test == 1)
+				lambda(i) = 1.0 + (i % 5);
+			else
+				lambda(i) = std::pow(10.0,-6.0 * i / Dimensions);
+		}
+		RealMatrix A = createRandomMatrix(lambda,Dimensions);
+		std::sort(lambda.begin(),lambda.end());
+		std::reverse(lambda.begin(),lambda.end());
+
+		RealVector eigenvalues;
+		RealMatrix eigenVectors;
+		eigensymm(A, eigenVectors, eigenvalues);
+
+		double error = max(abs(prod(trans(eigenVectors),eigenVectors)-identity_matrix<double>(Dimensions)));
+		BOOST_CHECK_SMALL(error,1.e-12);
+		BOOST_CHECK_SMALL(norm_inf(eigenvalues - lambda),1.e-12);
+		for(std::size_t i = 1; i != Dimensions; ++i){
+			BOOST_CHECK(eigenvalues(i) <= eigenvalues(i-1));
+		}
+		double error_orthogonalize = max(abs(
+			prod(prod(trans(eigenVectors),A),eigenVectors)-diagonal_matrix<RealVector>(eigenvalues)
+		));
+		BOOST_CHECK_SMALL(error_orthogonalize,1.e-12);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_eigensymm_partial )
+{
+	std::size_t Dimensions = 150;
+	std::size_t k = 5;
+	RealVector lambda(Dimensions);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		lambda(i) = 10.0 * std::pow(0.8,double(i));
+	}
+	RealMatrix A = createRandomMatrix(lambda,Dimensions);
+
+	RealVector eigenvalues;
+	RealMatrix eigenVectors;
+	eigensymm(A, eigenVectors, eigenvalues);
+
+	RealVector partialValues;
+	RealMatrix partialVectors;
+	std::size_t iterations = eigensymmPartial(A, k, partialVectors, partialValues, 1.e-12);
+	BOOST_REQUIRE_EQUAL(partialValues.size(), k);
+	BOOST_REQUIRE_EQUAL(partialVectors.size1(), Dimensions);
+	BOOST_REQUIRE_EQUAL(partialVectors.size2(), k);
+	BOOST_CHECK(iterations > 0);
+	BOOST_CHECK(iterations < 1000);
+	BOOST_CHECK_SMALL(norm_inf(partialValues - subrange(eigenvalues,0,k)),1.e-10);
+	double error = max(abs(prod(trans(partialVectors),partialVectors)-identity_matrix<double>(k)));
+	BOOST_CHECK_SMALL(error,1.e-10);
+	for(std::size_t i = 0; i != k; ++i){
+		//eigenvectors are only unique up to sign
+		BOOST_CHECK_SMALL(std::abs(inner_prod(column(partialVectors,i),column(eigenVectors,i))) - 1.0, 1.e-10);
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
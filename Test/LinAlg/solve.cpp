@@ -322,6 +322,51 @@ BOOST_AUTO_TEST_CASE( LinAlg_Solve_TriangularInPlace_Calls_Vector ){
 
 //for the remaining functions, we can use random systems and check, whether they are okay
 
+//the default kernels solve large systems blockwise
+BOOST_AUTO_TEST_CASE( LinAlg_Solve_Triangular_Blocked ){
+	std::size_t Dimensions = 211;
+	RealMatrix A(Dimensions,Dimensions,0.0);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		for(std::size_t j = 0; j < i; ++j){
+			A(i,j) = Rng::uni(-1,1)/Dimensions;
+		}
+		A(i,i) = Rng::uni(1,2);
+	}
+	RealMatrix Upper = trans(A);
+	RealMatrix B(Dimensions,150);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		for(std::size_t j = 0; j != 150; ++j){
+			B(i,j) = Rng::uni(-1,1);
+		}
+	}
+	RealVector b = column(B,0);
+	
+	//lower, matrix
+	{
+		RealMatrix X = B;
+		blas::bindings::trsm<false,false>(A,X,boost::mpl::false_());
+		BOOST_CHECK_SMALL(norm_inf(prod(A,X)-B),1.e-12);
+		blas::matrix<double,blas::column_major> XColumn = B;
+		blas::bindings::trsm<false,false>(A,XColumn,boost::mpl::false_());
+		BOOST_CHECK_SMALL(norm_inf(XColumn-X),1.e-12);
+	}
+	//upper, matrix
+	{
+		RealMatrix X = B;
+		blas::bindings::trsm<true,false>(Upper,X,boost::mpl::false_());
+		BOOST_CHECK_SMALL(norm_inf(prod(Upper,X)-B),1.e-12);
+	}
+	//lower and upper, vector
+	{
+		RealVector x = b;
+		blas::bindings::trsv<false,false>(A,x,boost::mpl::false_());
+		BOOST_CHECK_SMALL(norm_inf(prod(A,x)-b),1.e-12);
+		x = b;
+		blas::bindings::trsv<true,false>(Upper,x,boost::mpl::false_());
+		BOOST_CHECK_SMALL(norm_inf(prod(Upper,x)-b),1.e-12);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( LinAlg_Solve_Symmetric_Vector ){
 	unsigned int NumTests = 100;
 	std::size_t Dimensions = 50;
@@ -893,4 +938,64 @@ BOOST_AUTO_TEST_CASE( LinAlg_generalSolveSystemInPlace_Rectangular2_RankK ){
 	}
 }
 
+//operator version of a matrix for the conjugate gradient method
+struct MatrixOperator{
+	MatrixOperator(RealMatrix const& A):A(A){}
+	void operator()(RealMatrix const& P, RealMatrix& Q)const{
+		Q = prod(A,P);
+	}
+	RealMatrix const& A;
+};
+//diagonal preconditioner
+struct JacobiPreconditioner{
+	JacobiPreconditioner(RealMatrix const& A):diagonal(diag(A)){}
+	void operator()(RealMatrix const& R, RealMatrix& Z)const{
+		Z = R;
+		for(std::size_t i = 0; i != Z.size1(); ++i)
+			row(Z,i) /= diagonal(i);
+	}
+	RealVector diagonal;
+};
+
+BOOST_AUTO_TEST_CASE( LinAlg_Solve_Block_Conjugate_Gradient ){
+	unsigned int NumTests = 20;
+	std::size_t Dimensions = 50;
+	std::size_t numRhs = 6;
+	std::cout<<"block conjugate gradient"<<std::endl;
+	for(unsigned int testi = 0; testi != NumTests; ++testi){
+		RealMatrix A = createRandomInvertibleMatrix(Dimensions,0.1,2);
+		A = prod(A,trans(A));
+		for(std::size_t i = 0; i != Dimensions; ++i)
+			A(i,i) += 0.1 * (i+1);
+		RealMatrix B(Dimensions,numRhs);
+		for(std::size_t i = 0; i != Dimensions; ++i){
+			for(std::size_t j = 0; j != 4; ++j){
+				B(i,j) = Rng::gauss(0,1);
+			}
+		}
+		//a linearly dependent and a zero right hand side
+		noalias(column(B,4)) = column(B,0) - 2 * column(B,1);
+		column(B,5).clear();
+
+		MatrixOperator op(A);
+		RealMatrix X;
+		std::size_t iterations = blas::conjugateGradient(op,blas::IdentityPreconditioner(),X,B,1.e-10);
+		BOOST_CHECK(iterations < Dimensions);
+		RealMatrix test = prod(A,X);
+		BOOST_CHECK_SMALL(norm_inf(test-B),1.e-9);
+		BOOST_CHECK_EQUAL(norm_inf(column(X,5)), 0.0);
+
+		JacobiPreconditioner preconditioner(A);
+		RealMatrix XPre;
+		iterations = blas::conjugateGradient(op,preconditioner,XPre,B,1.e-10);
+		BOOST_CHECK(iterations < Dimensions);
+		test = prod(A,XPre);
+		BOOST_CHECK_SMALL(norm_inf(test-B),1.e-9);
+
+		//starting from the solution no iteration is needed
+		iterations = blas::conjugateGradient(op,preconditioner,XPre,B,1.e-8,true);
+		BOOST_CHECK_EQUAL(iterations, 0);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -142,4 +142,41 @@ BOOST_AUTO_TEST_CASE( GAUUSIAN_PROCESS_EVIDENCE )
 	}
 }
 
+//with full rank the low-rank evidence must agree with the exact evidence,
+//for smaller ranks the derivative must match the finite differences of the approximation
+BOOST_AUTO_TEST_CASE( GAUSSIAN_PROCESS_EVIDENCE_LOW_RANK )
+{
+	Rng::seed( 0 );
+	const std::size_t ell = 80;
+	GaussianRbfKernel<> kernel(1.0, true);
+	Wave prob;
+	RegressionDataset trainingData = prob.generateDataset(ell);
+
+	NegativeGaussianProcessEvidence<> exact(trainingData, &kernel, true);
+	NegativeGaussianProcessEvidence<> lowRank(trainingData, &kernel, true);
+	lowRank.setLowRankApproximation(ell,0.0);
+	BOOST_CHECK_EQUAL(lowRank.lowRankApproximation(), ell);
+	for(std::size_t test = 0; test != 10; ++test){
+		RealVector parameters(2);
+		parameters(0) = Rng::uni(-2,0);
+		parameters(1) = Rng::uni(-2,0);
+		SingleObjectiveFunction::FirstOrderDerivative exactDerivative;
+		SingleObjectiveFunction::FirstOrderDerivative lowRankDerivative;
+		double exactValue = exact.evalDerivative(parameters,exactDerivative);
+		double lowRankValue = lowRank.evalDerivative(parameters,lowRankDerivative);
+		BOOST_CHECK_CLOSE(exactValue, lowRankValue, 1.e-6);
+		BOOST_CHECK_CLOSE(lowRank.eval(parameters), lowRankValue, 1.e-10);
+		for(std::size_t i = 0; i != 2; ++i)
+			BOOST_CHECK_SMALL(exactDerivative(i) - lowRankDerivative(i), 1.e-6*(1+std::abs(exactDerivative(i))));
+	}
+
+	lowRank.setLowRankApproximation(15);
+	for(std::size_t test = 0; test != 20; ++test){
+		RealVector parameters(2);
+		parameters(0) = Rng::uni(-2,0);
+		parameters(1) = Rng::uni(-2,0);
+		testDerivative(lowRank,parameters,1.e-7,1.e-10,0.01);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
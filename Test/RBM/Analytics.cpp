@@ -123,4 +123,56 @@ BOOST_AUTO_TEST_CASE( Energy_NegLogLikelihood )
 	}
 }
 
+//AIS must approach the exact value of the log partition function
+BOOST_AUTO_TEST_CASE( Energy_AnnealedImportanceSampling )
+{
+	RBM<BinaryLayer,BinaryLayer,Rng::rng_type > rbm(Rng::globalRng);
+	rbm.setStructure(12,10);
+	Rng::seed(42);
+	
+	for(std::size_t i = 0; i != 3; ++i){
+		initRandomNormal(rbm,0.5);
+		double logPartition = logPartitionFunction(rbm);
+		
+		RealVector beta = linearBetaSchedule(200);
+		LogPartitionEstimate estimate = estimateLogPartitionFunction(rbm,beta,1000);
+		BOOST_REQUIRE_EQUAL(estimate.logWeights.size(), 1000u);
+		BOOST_CHECK_SMALL(estimate.logPartition - logPartition, 0.05);
+		BOOST_CHECK(estimate.standardError > 0);
+		BOOST_CHECK(estimate.standardError < 0.05);
+		BOOST_CHECK(estimate.logLowerBound < estimate.logPartition);
+		BOOST_CHECK(estimate.logUpperBound > estimate.logPartition);
+		BOOST_CHECK(estimate.effectiveSampleSize > 1);
+		BOOST_CHECK(estimate.effectiveSampleSize <= 1000+1.e-8);
+		
+		//the geometric schedule and a different batching must give the same result
+		LogPartitionEstimate estimateGeometric = estimateLogPartitionFunction(rbm,geometricBetaSchedule(200,0.01),1000,37);
+		BOOST_CHECK_SMALL(estimateGeometric.logPartition - logPartition, 0.05);
+	}
+}
+
+//with only two temperatures AIS is simple importance sampling with the beta=0 distribution as proposal
+BOOST_AUTO_TEST_CASE( Energy_AnnealedImportanceSampling_Schedules )
+{
+	RealVector linear = linearBetaSchedule(5);
+	BOOST_REQUIRE_EQUAL(linear.size(), 5u);
+	BOOST_CHECK_EQUAL(linear(0), 1.0);
+	BOOST_CHECK_EQUAL(linear(4), 0.0);
+	BOOST_CHECK_CLOSE(linear(1), 0.75, 1.e-10);
+	
+	RealVector geometric = geometricBetaSchedule(5,0.001);
+	BOOST_REQUIRE_EQUAL(geometric.size(), 5u);
+	BOOST_CHECK_EQUAL(geometric(0), 1.0);
+	BOOST_CHECK_CLOSE(geometric(1), 0.1, 1.e-10);
+	BOOST_CHECK_CLOSE(geometric(3), 0.001, 1.e-10);
+	BOOST_CHECK_EQUAL(geometric(4), 0.0);
+	
+	RBM<BinaryLayer,BinaryLayer,Rng::rng_type > rbm(Rng::globalRng);
+	rbm.setStructure(6,4);
+	Rng::seed(42);
+	initRandomNormal(rbm,0.2);
+	LogPartitionEstimate estimate = estimateLogPartitionFunction(rbm,linearBetaSchedule(2),20000);
+	BOOST_CHECK_SMALL(estimate.logPartition - logPartitionFunction(rbm), 0.01);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,197 @@
+#include <shark/Unsupervised/RBM/BinaryRBM.h>
+
+#define BOOST_TEST_MODULE RBM_BatchedTemperedMarkovChain
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (RBM_BatchedTemperedMarkovChain)
+
+BOOST_AUTO_TEST_CASE( BatchedTemperedMarkovChain_Distribution )
+{
+	const std::size_t numTemperatures = 5;
+	const std::size_t numChains = 4;
+	const std::size_t numSamples = 5000;
+
+	double states[]={
+		0,0,0,0,
+		1,0,0,0,
+		0,1,0,0,
+		1,1,0,0,
+		0,0,1,0,
+		1,0,1,0,
+		0,1,1,0,
+		1,1,1,0,
+		0,0,0,1,
+		1,0,0,1,
+		0,1,0,1,
+		1,1,0,1,
+		0,0,1,1,
+		1,0,1,1,
+		0,1,1,1,
+		1,1,1,1,
+	};
+	RealMatrix stateMatrix = blas::adapt_matrix(16,4,states);
+
+	//create rbm and pt object
+	Rng::seed(42);
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(4,4);
+	RealVector params(rbm.numberOfParameters());
+	for(std::size_t i = 0; i != params.size();++i){
+		params(i) = Rng::uni(-1,1);
+	}
+	rbm.setParameterVector(params);
+
+	BinaryBatchedPTChain pt(&rbm);
+	pt.setUniformTemperatureSpacing(numTemperatures);
+	pt.setBatchSize(numChains);
+	BOOST_REQUIRE_EQUAL(pt.batchSize(), numChains);
+	BOOST_REQUIRE_EQUAL(pt.samples().size(), numChains*numTemperatures);
+	pt.initializeChain(RealMatrix(numChains*numTemperatures,4,0));
+	pt.step(1000);//burn in
+
+	//evaluate distribution for all beta values
+	RealMatrix pHidden(numTemperatures,16);
+	RealMatrix pVisible(numTemperatures,16);
+	for(std::size_t i = 0; i != numTemperatures; ++i){
+		row(pHidden,i) =  exp(rbm.energy().logUnnormalizedProbabilityHidden(stateMatrix,blas::repeat(pt.beta(i),16)));
+		row(pVisible,i) =  exp(rbm.energy().logUnnormalizedProbabilityVisible(stateMatrix,blas::repeat(pt.beta(i),16)));
+		//normalize to 1
+		row(pHidden,i) /= sum(row(pHidden,i));
+		row(pVisible,i) /= sum(row(pVisible,i));
+	}
+
+	//the histograms are taken over all chains
+	RealMatrix pHiddenHist(numTemperatures,16,0.0);
+	RealMatrix pVisibleHist(numTemperatures,16,0.0);
+	for(std::size_t s = 0; s != numSamples; ++s){
+		pt.step(1);
+		for(std::size_t c = 0; c != numChains; ++c){
+			for(std::size_t t = 0; t != numTemperatures; ++t){
+				std::size_t stateH = 0;
+				std::size_t stateV = 0;
+				for(std::size_t i = 0; i != 4; ++i){
+					stateH += pt.samples().hidden.state(c*numTemperatures+t,i) > 0? (1<<i):0;
+					stateV += pt.samples().visible.state(c*numTemperatures+t,i) > 0? (1<<i):0;
+				}
+				pHiddenHist(t,stateH)+=1.0/(numSamples*numChains);
+				pVisibleHist(t,stateV)+=1.0/(numSamples*numChains);
+			}
+		}
+	}
+	//calculate KL divergence between distributions
+	for(std::size_t t = 0; t != numTemperatures; ++t){
+		double KLV= sum(row(pVisible*log(pVisible/pVisibleHist),t));
+		double KLH= sum(row(pHidden*log(pHidden/pHiddenHist),t));
+		BOOST_CHECK_SMALL(KLV,0.01);
+		BOOST_CHECK_SMALL(KLH,0.01);
+	}
+}
+
+//after the swaps the stored energies must still belong to the states they are stored with
+BOOST_AUTO_TEST_CASE( BatchedTemperedMarkovChain_SwapKeepsEnergy )
+{
+	Rng::seed(42);
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(6,5);
+	initRandomUniform(rbm,-1,1);
+
+	BinaryBatchedPTChain pt(&rbm);
+	pt.setUniformTemperatureSpacing(7);
+	pt.setBatchSize(3);
+	RealMatrix start(21,6);
+	for(std::size_t i = 0; i != 21; ++i){
+		for(std::size_t j = 0; j != 6; ++j){
+			start(i,j) = Rng::coinToss(0.5);
+		}
+	}
+	pt.initializeChain(start);
+
+	for(std::size_t s = 0; s != 50; ++s){
+		pt.step(1);
+		RealMatrix hiddenInput(21,5);
+		rbm.energy().inputHidden(hiddenInput,pt.samples().visible.state);
+		RealVector energies = rbm.energy().energyFromHiddenInput(
+			hiddenInput,pt.samples().hidden.state,pt.samples().visible.state
+		);
+		for(std::size_t i = 0; i != 21; ++i){
+			BOOST_CHECK_SMALL(energies(i) - pt.samples().energy(i), 1.e-10);
+			//the stored input must also belong to the visible state
+			BOOST_CHECK_SMALL(norm_inf(row(hiddenInput,i) - row(pt.samples().hidden.input,i)), 1.e-10);
+		}
+	}
+	//we ran long enough that at least one swap was accepted
+	BOOST_CHECK(sum(pt.swapRates()) > 0);
+}
+
+BOOST_AUTO_TEST_CASE( BatchedTemperedMarkovChain_SwapRates )
+{
+	Rng::seed(42);
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(6,5);
+	initRandomUniform(rbm,-2,2);
+
+	BinaryBatchedPTChain pt(&rbm);
+	pt.setUniformTemperatureSpacing(6);
+	pt.setBatchSize(4);
+	pt.initializeChain(RealMatrix(24,6,0.0));
+	BOOST_REQUIRE_EQUAL(pt.swapRates().size(), 5u);
+	BOOST_CHECK_EQUAL(norm_inf(pt.swapRates()), 0.0);
+
+	pt.step(100);
+	RealVector rates = pt.swapRates();
+	for(std::size_t i = 0; i != rates.size(); ++i){
+		BOOST_CHECK(rates(i) >= 0.0);
+		BOOST_CHECK(rates(i) <= 1.0);
+	}
+	BOOST_CHECK(sum(rates) > 0);
+
+	pt.resetSwapStatistics();
+	BOOST_CHECK_EQUAL(norm_inf(pt.swapRates()), 0.0);
+
+	//with all temperatures equal, every swap is accepted
+	for(std::size_t i = 0; i != 6; ++i){
+		pt.setBeta(i,1.0);
+	}
+	pt.step(10);
+	rates = pt.swapRates();
+	for(std::size_t i = 0; i != rates.size(); ++i){
+		BOOST_CHECK_EQUAL(rates(i), 1.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( BatchedTemperedMarkovChain_ModelSamples )
+{
+	Rng::seed(42);
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(6,5);
+	initRandomUniform(rbm,-1,1);
+
+	std::size_t numTemperatures = 4;
+	std::size_t numChains = 3;
+	BinaryBatchedPTChain pt(&rbm);
+	pt.setUniformTemperatureSpacing(numTemperatures);
+	pt.setBatchSize(numChains);
+	RealMatrix start(numChains*numTemperatures,6);
+	for(std::size_t i = 0; i != start.size1(); ++i){
+		for(std::size_t j = 0; j != 6; ++j){
+			start(i,j) = Rng::coinToss(0.5);
+		}
+	}
+	pt.initializeChain(start);
+	pt.step(5);
+
+	BinaryBatchedPTChain::SampleBatch samples = pt.modelSamples();
+	BOOST_REQUIRE_EQUAL(samples.size(), numChains);
+	for(std::size_t c = 0; c != numChains; ++c){
+		std::size_t r = c*numTemperatures;
+		BOOST_CHECK_EQUAL(samples.energy(c), pt.samples().energy(r));
+		BOOST_CHECK_EQUAL(norm_inf(row(samples.visible.state,c) - row(pt.samples().visible.state,r)), 0.0);
+		BOOST_CHECK_EQUAL(norm_inf(row(samples.hidden.state,c) - row(pt.samples().hidden.state,r)), 0.0);
+		BOOST_CHECK_EQUAL(norm_inf(row(samples.hidden.statistics,c) - row(pt.samples().hidden.statistics,r)), 0.0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
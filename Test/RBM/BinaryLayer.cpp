@@ -1,4 +1,5 @@
 #include <shark/Unsupervised/RBM/Neuronlayers/BinaryLayer.h>
+#include <shark/Unsupervised/RBM/BinaryRBM.h>
 #include <shark/Rng/GlobalRng.h>
 
 #define BOOST_TEST_MODULE RBM_BinaryLayer
@@ -126,4 +127,37 @@ BOOST_AUTO_TEST_CASE( BinaryLayer_LogMarginalize){
 	BOOST_CHECK_CLOSE(resultHalvedBeta , testResultHalvedBeta , 0.01);
  }
 
+//the locked sampling of the GibbsOperator must give the same result as sampling with an explicit generator
+BOOST_AUTO_TEST_CASE( BinaryLayer_GibbsOperatorExplicitRng){
+	Rng::seed(42);
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(5,7);
+	initRandomUniform(rbm,-1,1);
+	BinaryGibbsOperator gibbs(&rbm);
+
+	RealMatrix states(10,5);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 5; ++j){
+			states(i,j) = Rng::coinToss(0.5);
+		}
+	}
+	BinaryGibbsOperator::HiddenSampleBatch hiddenLocked(10,7);
+	BinaryGibbsOperator::HiddenSampleBatch hiddenExplicit(10,7);
+	BinaryGibbsOperator::VisibleSampleBatch visible(10,5);
+	visible.state = states;
+	gibbs.precomputeHidden(hiddenLocked,visible,blas::repeat(1.0,10));
+	gibbs.precomputeHidden(hiddenExplicit,visible,blas::repeat(1.0,10));
+
+	Rng::rng_type rng = Rng::globalRng;
+	gibbs.sampleHidden(hiddenLocked);
+	gibbs.sampleHidden(hiddenExplicit,rng);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 7; ++j){
+			BOOST_CHECK_EQUAL(hiddenLocked.state(i,j), hiddenExplicit.state(i,j));
+		}
+	}
+	//both generators must have advanced by the same number of draws
+	BOOST_CHECK(rng == Rng::globalRng);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -182,6 +182,37 @@ BOOST_AUTO_TEST_CASE( ContrastiveDivergence_ExactGradient)
 	}
 }
 
+//every thread samples with its own generator seeded from the RBM.
+//thus for a fixed seed and number of threads the gradient must be reproducible.
+BOOST_AUTO_TEST_CASE( ContrastiveDivergence_Reproducible ){
+	BarsAndStripes problem(4);
+	UnlabeledData<RealVector> data = problem.data();
+	
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(16,8);
+	Rng::seed(42);
+	initRandomUniform(rbm,-0.1,0.1);
+	RealVector params = rbm.parameterVector();
+	BinaryCD cd(&rbm);
+	cd.setK(3);
+	cd.setData(data);
+	
+	Rng::seed(13);
+	BinaryCD::FirstOrderDerivative der1;
+	cd.evalDerivative(params,der1);
+	Rng::seed(13);
+	BinaryCD::FirstOrderDerivative der2;
+	cd.evalDerivative(params,der2);
+	//the per thread results are summed in arbitrary order, which only affects rounding
+	BOOST_CHECK_SMALL(norm_inf(der1-der2), 1.e-12);
+	
+	//a different seed leads to a different gradient
+	Rng::seed(14);
+	BinaryCD::FirstOrderDerivative der3;
+	cd.evalDerivative(params,der3);
+	BOOST_CHECK(norm_inf(der1-der3) > 1.e-12);
+}
+
 BOOST_AUTO_TEST_CASE( ContrastiveDivergenceTraining_Bars ){
 	
 	unsigned int trials = 1;
@@ -0,0 +1,117 @@
+#include <shark/Unsupervised/RBM/StateSpaces/PackedBinaryStates.h>
+#include <shark/Rng/GlobalRng.h>
+
+#define BOOST_TEST_MODULE RBM_PackedBinaryStates
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (RBM_PackedBinaryStates)
+
+//sizes are chosen to test the handling of partially filled words
+BOOST_AUTO_TEST_CASE( PackedBinaryMatrix_PackUnpack){
+	Rng::seed(42);
+	std::size_t sizes[] = {1,63,64,65,200};
+	for(std::size_t s = 0; s != 5; ++s){
+		std::size_t n = sizes[s];
+		RealMatrix states(7,n);
+		for(std::size_t i = 0; i != 7; ++i){
+			for(std::size_t j = 0; j != n; ++j){
+				states(i,j) = Rng::coinToss(0.3);
+			}
+		}
+		PackedBinaryMatrix packed(states);
+		BOOST_REQUIRE_EQUAL(packed.size1(), 7u);
+		BOOST_REQUIRE_EQUAL(packed.size2(), n);
+
+		RealMatrix unpacked(7,n);
+		packed.unpack(unpacked);
+		for(std::size_t i = 0; i != 7; ++i){
+			BOOST_CHECK_EQUAL(packed.count(i), std::size_t(sum(row(states,i))));
+			for(std::size_t j = 0; j != n; ++j){
+				BOOST_CHECK_EQUAL(unpacked(i,j), states(i,j));
+				BOOST_CHECK_EQUAL(packed(i,j), states(i,j) > 0);
+			}
+		}
+
+		//flip all states and check that set works
+		for(std::size_t i = 0; i != 7; ++i){
+			for(std::size_t j = 0; j != n; ++j){
+				packed.set(i,j,states(i,j) == 0);
+			}
+			BOOST_CHECK_EQUAL(packed.count(i), n - std::size_t(sum(row(states,i))));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( PackedBinaryMatrix_Prod){
+	Rng::seed(42);
+	std::size_t numStates = 10;
+	std::size_t numHidden = 130;
+	std::size_t numVisible = 17;
+	RealMatrix states(numStates,numHidden);
+	RealMatrix weights(numHidden,numVisible);
+	for(std::size_t i = 0; i != numStates; ++i){
+		for(std::size_t j = 0; j != numHidden; ++j){
+			states(i,j) = Rng::coinToss(0.5);
+		}
+	}
+	for(std::size_t i = 0; i != numHidden; ++i){
+		for(std::size_t j = 0; j != numVisible; ++j){
+			weights(i,j) = Rng::gauss(0,1);
+		}
+	}
+	PackedBinaryMatrix packed(states);
+
+	RealMatrix result(numStates,numVisible,1.0);
+	packedProd(packed,weights,result);
+	RealMatrix test = prod(states,weights);
+	for(std::size_t i = 0; i != numStates; ++i){
+		for(std::size_t j = 0; j != numVisible; ++j){
+			BOOST_CHECK_SMALL(result(i,j) - test(i,j), 1.e-12);
+		}
+	}
+
+	//transposed weights, as used for the input of the hidden units
+	RealMatrix weightsT = trans(weights);
+	RealMatrix visibleStates(numStates,numVisible);
+	for(std::size_t i = 0; i != numStates; ++i){
+		for(std::size_t j = 0; j != numVisible; ++j){
+			visibleStates(i,j) = Rng::coinToss(0.5);
+		}
+	}
+	PackedBinaryMatrix packedVisible(visibleStates);
+	RealMatrix resultHidden(numStates,numHidden);
+	packedProd(packedVisible,weightsT,resultHidden);
+	RealMatrix testHidden = prod(visibleStates,trans(weights));
+	for(std::size_t i = 0; i != numStates; ++i){
+		for(std::size_t j = 0; j != numHidden; ++j){
+			BOOST_CHECK_SMALL(resultHidden(i,j) - testHidden(i,j), 1.e-12);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( PackedBinaryMatrix_InnerProducts){
+	Rng::seed(42);
+	RealMatrix states1(5,100);
+	RealMatrix states2(8,100);
+	for(std::size_t j = 0; j != 100; ++j){
+		for(std::size_t i = 0; i != 5; ++i){
+			states1(i,j) = Rng::coinToss(0.5);
+		}
+		for(std::size_t i = 0; i != 8; ++i){
+			states2(i,j) = Rng::coinToss(0.5);
+		}
+	}
+	RealMatrix result(5,8);
+	packedInnerProducts(PackedBinaryMatrix(states1),PackedBinaryMatrix(states2),result);
+	RealMatrix test = prod(states1,trans(states2));
+	for(std::size_t i = 0; i != 5; ++i){
+		for(std::size_t j = 0; j != 8; ++j){
+			BOOST_CHECK_EQUAL(result(i,j), test(i,j));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
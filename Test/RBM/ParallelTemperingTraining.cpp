@@ -58,4 +58,47 @@ BOOST_AUTO_TEST_CASE( ParallelTemperingTraining_Bars ){
 	}
 }
 
+//same as above, but with several chains running in parallel and sampled as one batch
+BOOST_AUTO_TEST_CASE( BatchedParallelTemperingTraining_Bars ){
+	unsigned int steps = 3001;
+	unsigned int updateStep = 1000;
+	std::size_t numHidden = 8;
+	std::size_t numTemperatures = 5;
+	double learningRate = 0.1;
+	
+	BarsAndStripes problem(8);
+	UnlabeledData<RealVector> data = problem.data();
+	
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(16,numHidden);
+	
+	Rng::seed(42);
+	RealVector params(rbm.numberOfParameters());
+	for(std::size_t i = 0; i != params.size();++i){
+		params(i) = Rng::uni(-0.1,0.1);
+	}
+	rbm.setParameterVector(params);
+	BinaryBatchedParallelTempering cd(&rbm);
+	cd.chain().setUniformTemperatureSpacing(numTemperatures);
+	cd.setNumberOfSamples(8);
+	cd.numBatches()=2;
+	cd.setData(data);
+
+	SteepestDescent optimizer;
+	optimizer.setLearningRate(learningRate);
+	optimizer.setMomentum(0);
+	optimizer.init(cd);
+
+	double logLikelyHood = 0;
+	for(std::size_t i = 0; i != steps; ++i){
+		if(i % updateStep == 0){
+			rbm.setParameterVector(optimizer.solution().point);
+			logLikelyHood = negativeLogLikelihood(rbm,data);
+			std::cout<<i<<" "<<logLikelyHood<<std::endl;
+		}
+		optimizer.step(cd);
+	}
+	BOOST_CHECK( logLikelyHood<200.0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+#include <shark/LinAlg/Base.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+#include <cmath>
+using namespace shark;
+using namespace std;
+
+//runs f repeatedly until at least 0.2 seconds passed and returns the time per element in nanoseconds
+template<class F>
+double timePerElement(F f, std::size_t elements){
+	std::size_t runs = 0;
+	Timer timer;
+	do{
+		f();
+		++runs;
+	}while(timer.stop() < 0.2);
+	return timer.stop() / runs / elements * 1.e9;
+}
+
+RealVector randomVector(std::size_t n){
+	RealVector v(n);
+	for(std::size_t i = 0; i != n; ++i)
+		v(i) = Rng::uni(-1,1);
+	return v;
+}
+
+RealMatrix randomMatrix(std::size_t n, std::size_t m){
+	RealMatrix A(n,m);
+	for(std::size_t i = 0; i != n; ++i)
+		for(std::size_t j = 0; j != m; ++j)
+			A(i,j) = Rng::uni(-1,1);
+	return A;
+}
+
+//compares the time of common elementwise expressions used in the neural network and kernel code
+//with a hand written loop over the raw memory. Both columns should be close when the expression
+//is lowered to the fused kernel. The last expression works on a matrix column and thus is not contiguous.
+int main(int argc, char **argv) {
+	std::size_t sizes[] = {1000, 100000, 1000000};
+	cout<<"expression size expression_ns/element loop_ns/element"<<endl;
+	for(std::size_t s = 0; s != 3; ++s){
+		std::size_t n = sizes[s];
+		RealVector a = randomVector(n);
+		RealVector b = randomVector(n);
+		RealVector c = randomVector(n);
+		RealVector r(n);
+		double alpha = 0.5;
+		double* pa = &a(0);
+		double* pb = &b(0);
+		double* pc = &c(0);
+		double* pr = &r(0);
+
+		cout<<"r+=alpha*a "<<n<<" "
+		<<timePerElement([&]{noalias(r) += alpha * a;},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pr[i] += alpha * pa[i];},n)<<endl;
+
+		cout<<"r=a*b+c "<<n<<" "
+		<<timePerElement([&]{noalias(r) = a * b + c;},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pr[i] = pa[i] * pb[i] + pc[i];},n)<<endl;
+
+		cout<<"r=exp(a+b) "<<n<<" "
+		<<timePerElement([&]{noalias(r) = exp(a + b);},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pr[i] = std::exp(pa[i] + pb[i]);},n)<<endl;
+
+		cout<<"r=sigmoid(a) "<<n<<" "
+		<<timePerElement([&]{noalias(r) = sigmoid(a);},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pr[i] = 1.0/(1.0 + std::exp(-pa[i]));},n)<<endl;
+
+		cout<<"r=tanh(a) "<<n<<" "
+		<<timePerElement([&]{noalias(r) = tanh(a);},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pr[i] = std::tanh(pa[i]);},n)<<endl;
+
+		cout<<"r=max(a,0) "<<n<<" "
+		<<timePerElement([&]{noalias(r) = max(a,0.0);},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pr[i] = std::max(pa[i],0.0);},n)<<endl;
+	}
+
+	std::size_t batchSize = 256;
+	std::size_t neurons[] = {100, 1000};
+	for(std::size_t s = 0; s != 2; ++s){
+		std::size_t m = neurons[s];
+		std::size_t n = batchSize * m;
+		RealMatrix A = randomMatrix(batchSize,m);
+		RealMatrix B = randomMatrix(batchSize,m);
+		RealMatrix R(batchSize,m);
+		RealVector bias = randomVector(m);
+		double* pA = &A(0,0);
+		double* pB = &B(0,0);
+		double* pR = &R(0,0);
+		double* pbias = &bias(0);
+
+		cout<<"R+=repeat(bias) "<<n<<" "
+		<<timePerElement([&]{noalias(R) += repeat(bias,batchSize);},n)<<" "
+		<<timePerElement([&]{
+			for(std::size_t i = 0; i != batchSize; ++i)
+				for(std::size_t j = 0; j != m; ++j)
+					pR[i*m+j] += pbias[j];
+		},n)<<endl;
+
+		cout<<"R=tanh(A)*B "<<n<<" "
+		<<timePerElement([&]{noalias(R) = tanh(A)*B;},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pR[i] = std::tanh(pA[i]) * pB[i];},n)<<endl;
+
+		cout<<"R-=0.1*(A-B) "<<n<<" "
+		<<timePerElement([&]{noalias(R) -= 0.1*(A - B);},n)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != n; ++i) pR[i] -= 0.1 * (pA[i] - pB[i]);},n)<<endl;
+
+		cout<<"column(R)+=column(A) "<<batchSize<<" "
+		<<timePerElement([&]{noalias(column(R,0)) += column(A,0);},batchSize)<<" "
+		<<timePerElement([&]{for(std::size_t i = 0; i != batchSize; ++i) pR[i*m] += pA[i*m];},batchSize)<<endl;
+	}
+}
@@ -0,0 +1,52 @@
+#include <shark/Algorithms/NearestNeighbors/SimpleNearestNeighbors.h>
+#include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//queries per second of the brute force nearest neighbor search
+//for different numbers of queries per batch, dimensions and neighbors
+int main(int argc, char **argv) {
+	std::size_t numPoints = 20000;
+	std::size_t dims[] = {16,128};
+	std::size_t numQueries[] = {1,64,1024};
+	std::size_t ks[] = {1,10,100};
+
+	cout<<"dim queries k qps"<<endl;
+	for(std::size_t d = 0; d != 2; ++d){
+		std::size_t dim = dims[d];
+		std::vector<RealVector> points(numPoints,RealVector(dim));
+		std::vector<unsigned int> labels(numPoints);
+		for(std::size_t i = 0; i != numPoints; ++i){
+			for(std::size_t j = 0; j != dim; ++j){
+				points[i](j) = Rng::gauss();
+			}
+			labels[i] = (unsigned int) i;
+		}
+		LabeledData<RealVector,unsigned int> data = createLabeledDataFromRange(points,labels);
+		LinearKernel<RealVector> euclideanKernel;
+		SimpleNearestNeighbors<RealVector,unsigned int> algorithm(data,&euclideanKernel);
+
+		for(std::size_t q = 0; q != 3; ++q){
+			RealMatrix queries(numQueries[q],dim);
+			for(std::size_t i = 0; i != queries.size1(); ++i){
+				for(std::size_t j = 0; j != dim; ++j){
+					queries(i,j) = Rng::gauss();
+				}
+			}
+			for(std::size_t k = 0; k != 3; ++k){
+				//repeat small query batches to get a measurable time
+				std::size_t repetitions = std::max<std::size_t>(1,1024/numQueries[q]);
+				Timer time;
+				for(std::size_t r = 0; r != repetitions; ++r){
+					algorithm.getNeighbors(queries,ks[k]);
+				}
+				double timeTaken = time.stop();
+				cout<<dim<<" "<<numQueries[q]<<" "<<ks[k]<<" "<<repetitions*numQueries[q]/timeTaken<<endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#include <shark/LinAlg/Cholesky.h>
+#include <shark/LinAlg/solveTriangular.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//time of the blocked cholesky decomposition compared to the unblocked kernel
+//and of the triangular solve with n right hand sides
+int main(int argc, char **argv) {
+	std::size_t sizes[] = {250,500,1000,2000,4000};
+
+	cout<<"n blocked unblocked trsm"<<endl;
+	for(std::size_t s = 0; s != 5; ++s){
+		std::size_t n = sizes[s];
+		RealMatrix X(n,n);
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != n; ++j){
+				X(i,j) = Rng::gauss();
+			}
+		}
+		RealMatrix A = prod(X,trans(X));
+		diag(A) += blas::repeat(double(n),n);
+
+		RealMatrix L(n,n);
+		Timer timeBlocked;
+		choleskyDecomposition(A,L);
+		double blockedTime = timeBlocked.stop();
+
+		//the unblocked kernel is too slow for the large matrices
+		double unblockedTime = 0;
+		if(n <= 2000){
+			RealMatrix LUnblocked = A;
+			Timer timeUnblocked;
+			blas::bindings::potrf_impl(LUnblocked,blas::row_major(),blas::lower());
+			unblockedTime = timeUnblocked.stop();
+		}
+
+		RealMatrix B = X;
+		Timer timeTrsm;
+		blas::solveTriangularSystemInPlace<blas::SolveAXB,blas::lower>(L,B);
+		double trsmTime = timeTrsm.stop();
+
+		cout<<n<<" "<<blockedTime<<" "<<unblockedTime<<" "<<trsmTime<<endl;
+	}
+}
@@ -0,0 +1,60 @@
+#include <shark/Unsupervised/RBM/ConvolutionalBinaryRBM.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//measures the time of the three convolutions of a ConvolutionalRBM:
+//the input of the hidden units, the input of the visible units and the filter gradient
+int main(int argc, char **argv) {
+	std::size_t imageSizes[] = {16,32,64};
+	std::size_t filterSizes[] = {3,5,9,15};
+	std::size_t numFilters = 16;
+	std::size_t batchSize = 64;
+
+	cout<<"image filter hidden visible gradient"<<endl;
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t f = 0; f != 4; ++f){
+			std::size_t imageSize = imageSizes[i];
+			std::size_t filterSize = filterSizes[f];
+			if(filterSize >= imageSize) continue;
+
+			ConvolutionalBinaryRBM rbm(Rng::globalRng);
+			rbm.setStructure(imageSize,imageSize,numFilters,filterSize);
+			initRandomUniform(rbm,-0.1,0.1);
+
+			RealMatrix visible(batchSize,rbm.numberOfVN());
+			RealMatrix hidden(batchSize,rbm.numberOfHN());
+			for(std::size_t j = 0; j != batchSize; ++j){
+				for(std::size_t k = 0; k != rbm.numberOfVN(); ++k){
+					visible(j,k) = Rng::coinToss(0.5);
+				}
+				for(std::size_t k = 0; k != rbm.numberOfHN(); ++k){
+					hidden(j,k) = Rng::coinToss(0.1);
+				}
+			}
+			RealMatrix hiddenInput(batchSize,rbm.numberOfHN());
+			RealMatrix visibleInput(batchSize,rbm.numberOfVN());
+
+			Timer timeHidden;
+			rbm.inputHidden(hiddenInput,visible);
+			double hiddenTime = timeHidden.stop();
+
+			Timer timeVisible;
+			rbm.inputVisible(visibleInput,hidden);
+			double visibleTime = timeVisible.stop();
+
+			ConvolutionalBinaryGibbsOperator::HiddenSampleBatch hiddenBatch(batchSize,rbm.numberOfHN());
+			ConvolutionalBinaryGibbsOperator::VisibleSampleBatch visibleBatch(batchSize,rbm.numberOfVN());
+			ConvolutionalBinaryGibbsOperator gibbs(&rbm);
+			gibbs.createSample(hiddenBatch,visibleBatch,visible);
+			ConvolutionalBinaryRBM::GradientType gradient(&rbm);
+			Timer timeGradient;
+			gradient.addVH(hiddenBatch,visibleBatch);
+			double gradientTime = timeGradient.stop();
+
+			cout<<imageSize<<" "<<filterSize<<" "<<hiddenTime<<" "<<visibleTime<<" "<<gradientTime<<endl;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#include <shark/LinAlg/eigenvalues.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//time of the full symmetric eigenvalue decomposition and of computing
+//the 10 largest eigenpairs of a covariance-like matrix
+int main(int argc, char **argv) {
+	std::size_t sizes[] = {250,500,1000,2000};
+
+	cout<<"n full top10"<<endl;
+	for(std::size_t s = 0; s != 4; ++s){
+		std::size_t n = sizes[s];
+		//low rank plus noise, the typical shape of a sample covariance
+		RealMatrix X(n,50);
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != 50; ++j){
+				X(i,j) = Rng::gauss() / (j + 1.0);
+			}
+		}
+		RealMatrix A = prod(X,trans(X));
+		diag(A) += blas::repeat(0.01,n);
+
+		RealMatrix U;
+		RealVector lambda;
+		Timer timeFull;
+		eigensymm(A,U,lambda);
+		double fullTime = timeFull.stop();
+
+		RealMatrix UPartial;
+		RealVector lambdaPartial;
+		Timer timePartial;
+		eigensymmPartial(A,10,UPartial,lambdaPartial);
+		double partialTime = timePartial.stop();
+
+		cout<<n<<" "<<fullTime<<" "<<partialTime<<endl;
+	}
+}
@@ -0,0 +1,76 @@
+#include <shark/Algorithms/NearestNeighbors/HNSWNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/SimpleNearestNeighbors.h>
+#include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//recall@k and queries per second of the HNSW graph for different search widths,
+//compared to brute force search on clustered synthetic data
+int main(int argc, char **argv) {
+	std::size_t numPoints = 50000;
+	std::size_t numQueries = 1000;
+	std::size_t dim = 128;
+	std::size_t numClusters = 100;
+	std::size_t k = 10;
+
+	//points are drawn around random cluster centers
+	RealMatrix centers(numClusters,dim);
+	for(std::size_t c = 0; c != numClusters; ++c){
+		for(std::size_t j = 0; j != dim; ++j){
+			centers(c,j) = Rng::gauss(0,3);
+		}
+	}
+	std::vector<RealVector> points(numPoints,RealVector(dim));
+	std::vector<unsigned int> labels(numPoints);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		std::size_t c = Rng::discrete(0,numClusters-1);
+		for(std::size_t j = 0; j != dim; ++j){
+			points[i](j) = centers(c,j) + Rng::gauss();
+		}
+		labels[i] = (unsigned int) i;
+	}
+	RealMatrix queries(numQueries,dim);
+	for(std::size_t i = 0; i != numQueries; ++i){
+		std::size_t c = Rng::discrete(0,numClusters-1);
+		for(std::size_t j = 0; j != dim; ++j){
+			queries(i,j) = centers(c,j) + Rng::gauss();
+		}
+	}
+	LabeledData<RealVector,unsigned int> data = createLabeledDataFromRange(points,labels);
+
+	LinearKernel<RealVector> euclideanKernel;
+	SimpleNearestNeighbors<RealVector,unsigned int> simpleAlgorithm(data,&euclideanKernel);
+	Timer timeSimple;
+	std::vector<KeyValuePair<double,unsigned int> > reference = simpleAlgorithm.getNeighbors(queries,k);
+	double simpleTime = timeSimple.stop();
+	cout<<"brute-force: recall 1 qps "<<numQueries/simpleTime<<endl;
+
+	Timer timeBuild;
+	HNSWGraph graph(data.inputs(),16,200);
+	double buildTime = timeBuild.stop();
+	cout<<"hnsw build time: "<<buildTime<<endl;
+
+	HNSWNearestNeighbors<RealVector,unsigned int> hnsw(data,&graph);
+	std::size_t efs[] = {10,20,40,80,160,320};
+	cout<<"ef recall qps"<<endl;
+	for(std::size_t e = 0; e != 6; ++e){
+		hnsw.setEf(efs[e]);
+		Timer timeQuery;
+		std::vector<KeyValuePair<double,unsigned int> > neighbors = hnsw.getNeighbors(queries,k);
+		double queryTime = timeQuery.stop();
+
+		std::size_t hits = 0;
+		for(std::size_t q = 0; q != numQueries; ++q){
+			for(std::size_t i = 0; i != k; ++i){
+				for(std::size_t j = 0; j != k; ++j){
+					if(neighbors[q*k+i].value == reference[q*k+j].value) ++hits;
+				}
+			}
+		}
+		cout<<efs[e]<<" "<<double(hits)/(numQueries*k)<<" "<<numQueries/queryTime<<endl;
+	}
+}
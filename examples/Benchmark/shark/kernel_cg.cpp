@@ -0,0 +1,56 @@
+#include <shark/LinAlg/KernelMatrixOperator.h>
+#include <shark/LinAlg/solveSystem.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Data/DataDistribution.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//time and number of iterations of the conjugate gradient method on a regularized kernel matrix
+//which is never stored, with and without pivoted Cholesky preconditioner, for one and for 8 right hand sides.
+//The Cholesky solver on the stored matrix is given for comparison.
+int main(int argc, char **argv) {
+	std::size_t n = 3000;
+	double regularizer = 0.01;
+	Wave prob(0.1, 5.0);
+	RegressionDataset data = prob.generateDataset(n);
+	GaussianRbfKernel<> kernel(0.5);
+
+	RealMatrix B(n,8);
+	for(std::size_t i = 0; i != n; ++i){
+		B(i,0) = data.labels().element(i)(0);
+		for(std::size_t j = 1; j != 8; ++j)
+			B(i,j) = Rng::gauss(0,1);
+	}
+
+	Timer choleskyTimer;
+	RealMatrix M = calculateRegularizedKernelMatrix(kernel,data.inputs(),regularizer);
+	RealMatrix exact;
+	blas::solveSymmPosDefSystem<blas::SolveAXB>(M,exact,B);
+	double choleskyTime = choleskyTimer.stop();
+	cout<<"n="<<n<<" cholesky time="<<choleskyTime<<endl;
+
+	KernelMatrixOperator<RealVector> K(kernel,data.inputs(),regularizer);
+	cout<<"rhs preconditioner_rank iterations time max_error"<<endl;
+	std::size_t ranks[] = {0, 20, 50, 100};
+	std::size_t rhs[] = {1, 8};
+	for(std::size_t k = 0; k != 2; ++k){
+		RealMatrix Bk = columns(B,0,rhs[k]);
+		for(std::size_t r = 0; r != 4; ++r){
+			RealMatrix X;
+			Timer timer;
+			std::size_t iterations = 0;
+			if(ranks[r] == 0){
+				iterations = blas::conjugateGradient(K,blas::IdentityPreconditioner(),X,Bk,1.e-8,false,1000);
+			}else{
+				PivotedCholeskyPreconditioner<RealVector> preconditioner(kernel,data.inputs(),regularizer,ranks[r]);
+				iterations = blas::conjugateGradient(K,preconditioner,X,Bk,1.e-8,false,1000);
+			}
+			double time = timer.stop();
+			RealMatrix error = X - columns(exact,0,rhs[k]);
+			cout<<rhs[k]<<" "<<ranks[r]<<" "<<iterations<<" "<<time<<" "<<max(abs(error))<<endl;
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#include <shark/Algorithms/KMeans.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//time of the k-means seeding, the full k-means iterations and mini-batch k-means
+//on clustered synthetic data
+int main(int argc, char **argv) {
+	std::size_t numPoints = 100000;
+	std::size_t dim = 16;
+	std::size_t ks[] = {10,100,1000};
+
+	RealMatrix means(100,dim);
+	for(std::size_t c = 0; c != 100; ++c){
+		for(std::size_t j = 0; j != dim; ++j){
+			means(c,j) = Rng::gauss(0,5);
+		}
+	}
+	std::vector<RealVector> points(numPoints,RealVector(dim));
+	for(std::size_t i = 0; i != numPoints; ++i){
+		std::size_t c = Rng::discrete(0,99);
+		for(std::size_t j = 0; j != dim; ++j){
+			points[i](j) = means(c,j) + Rng::gauss();
+		}
+	}
+	Data<RealVector> data = createDataFromRange(points);
+
+	cout<<"k seeding kmeans iterations minibatch"<<endl;
+	for(std::size_t i = 0; i != 3; ++i){
+		std::size_t k = ks[i];
+		Centroids centroids;
+		Timer timeSeeding;
+		initKMeansParallel(data,k,centroids);
+		double seedingTime = timeSeeding.stop();
+
+		Timer timeKMeans;
+		std::size_t iterations = kMeans(data,k,centroids,100);
+		double kMeansTime = timeKMeans.stop();
+
+		Centroids miniBatchCentroids;
+		Timer timeMiniBatch;
+		miniBatchKMeans(data,k,miniBatchCentroids,1000);
+		double miniBatchTime = timeMiniBatch.stop();
+
+		cout<<k<<" "<<seedingTime<<" "<<kMeansTime<<" "<<iterations<<" "<<miniBatchTime<<endl;
+	}
+}
@@ -0,0 +1,59 @@
+#include <shark/Algorithms/Trainers/LassoRegression.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//time to compute a regularization path of 100 values of lambda
+//on a wide sparse dataset and on a tall dense dataset
+int main(int argc, char **argv) {
+	std::size_t numLambdas = 100;
+	{
+		std::size_t n = 2000;
+		std::size_t dim = 20000;
+		std::size_t nonzeros = 100;
+		std::vector<CompressedRealVector> inputs(n, CompressedRealVector(dim));
+		std::vector<RealVector> labels(n, RealVector(1, 0.0));
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t k = 0; k != nonzeros; ++k){
+				std::size_t j = Rng::discrete(0, dim - 1);
+				double value = Rng::gauss();
+				inputs[i](j) = value;
+				if(j < 50) labels[i](0) += value;
+			}
+			labels[i](0) += 0.1 * Rng::gauss();
+		}
+		LabeledData<CompressedRealVector, RealVector> data = createLabeledDataFromRange(inputs, labels);
+		LassoRegression<CompressedRealVector> trainer(1.0, 1.e-4);
+		Timer timer;
+		RealVector lambdas = trainer.lambdaPath(data, numLambdas, 1.e-3);
+		RealMatrix path = trainer.trainPath(data, lambdas);
+		double time = timer.stop();
+		std::size_t active = 0;
+		for(std::size_t j = 0; j != dim; ++j){
+			if(path(numLambdas - 1, j) != 0.0) ++active;
+		}
+		cout<<"sparse n="<<n<<" d="<<dim<<" time="<<time<<" nonzero weights="<<active<<endl;
+	}
+	{
+		std::size_t n = 50000;
+		std::size_t dim = 200;
+		std::vector<RealVector> inputs(n, RealVector(dim));
+		std::vector<RealVector> labels(n, RealVector(1, 0.0));
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != dim; ++j){
+				inputs[i](j) = Rng::gauss();
+			}
+			labels[i](0) = sum(subrange(inputs[i], 0, 20)) + 0.1 * Rng::gauss();
+		}
+		LabeledData<RealVector, RealVector> data = createLabeledDataFromRange(inputs, labels);
+		LassoRegression<RealVector> trainer(1.0, 1.e-4);
+		Timer timer;
+		RealVector lambdas = trainer.lambdaPath(data, numLambdas, 1.e-3);
+		RealMatrix path = trainer.trainPath(data, lambdas);
+		double time = timer.stop();
+		cout<<"dense n="<<n<<" d="<<dim<<" time="<<time<<endl;
+	}
+}
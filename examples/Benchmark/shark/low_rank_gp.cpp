@@ -0,0 +1,86 @@
+#include <shark/Algorithms/Trainers/RegularizationNetworkTrainer.h>
+#include <shark/ObjectiveFunctions/NegativeGaussianProcessEvidence.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/Data/Csv.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//accuracy of the low-rank regularization network against the rank on the regression data shipped
+//with the examples, and time of training and of the evidence gradient against the rank on a large problem.
+//usage: Low_Rank_GP [inputs.csv labels.csv]
+int main(int argc, char **argv) {
+	string inputFile = "data/regressionInputs.csv";
+	string labelFile = "data/regressionLabels.csv";
+	if(argc == 3){
+		inputFile = argv[1];
+		labelFile = argv[2];
+	}
+	SquaredLoss<> loss;
+	try{
+		Data<RealVector> inputs;
+		Data<RealVector> labels;
+		importCSV(inputs, inputFile, ' ');
+		importCSV(labels, labelFile, ' ');
+		//every fourth point is used for testing
+		std::vector<RealVector> trainInputs, trainLabels, testInputs, testLabels;
+		for(std::size_t i = 0; i != inputs.numberOfElements(); ++i){
+			std::vector<RealVector>& x = (i % 4 == 3)? testInputs: trainInputs;
+			std::vector<RealVector>& y = (i % 4 == 3)? testLabels: trainLabels;
+			x.push_back(inputs.element(i));
+			y.push_back(labels.element(i));
+		}
+		RegressionDataset data = createLabeledDataFromRange(trainInputs, trainLabels);
+		RegressionDataset test = createLabeledDataFromRange(testInputs, testLabels);
+
+		GaussianRbfKernel<> kernel(0.1);
+		RegularizationNetworkTrainer<RealVector> trainer(&kernel, 0.05);
+		KernelExpansion<RealVector> model;
+		trainer.train(model, data);
+		double exactTest = loss.eval(test.labels(), model(test.inputs()));
+		cout<<inputFile<<": n="<<data.numberOfElements()<<" exact test error="<<exactTest<<endl;
+		cout<<"rank train_error test_error"<<endl;
+		for(std::size_t rank = 1; rank <= data.numberOfElements(); ++rank){
+			trainer.setLowRankApproximation(rank);
+			trainer.train(model, data);
+			//the decomposition stopped at the numerical rank
+			if(model.basis().numberOfElements() < rank) break;
+			cout<<model.basis().numberOfElements()
+			<<" "<<loss.eval(data.labels(), model(data.inputs()))
+			<<" "<<loss.eval(test.labels(), model(test.inputs()))<<endl;
+		}
+	}catch(std::exception const& e){
+		cout<<"could not read "<<inputFile<<" and "<<labelFile<<": "<<e.what()<<endl;
+	}
+
+	Wave prob(0.1, 5.0);
+	RegressionDataset data = prob.generateDataset(5000);
+	RegressionDataset test = prob.generateDataset(5000);
+	GaussianRbfKernel<> kernel(0.5, true);
+	RegularizationNetworkTrainer<RealVector> trainer(&kernel, 0.01, true);
+	NegativeGaussianProcessEvidence<> evidence(data, &kernel, true);
+	RealVector params = trainer.parameterVector();
+	KernelExpansion<RealVector> model;
+
+	cout<<"Wave n="<<data.numberOfElements()<<endl;
+	cout<<"rank train_time gradient_time test_error evidence"<<endl;
+	std::size_t ranks[] = {10, 20, 50, 100, 200, 0};
+	for(std::size_t r = 0; r != 6; ++r){
+		trainer.setLowRankApproximation(ranks[r]);
+		evidence.setLowRankApproximation(ranks[r]);
+		Timer trainTimer;
+		trainer.train(model, data);
+		double trainTime = trainTimer.stop();
+		SingleObjectiveFunction::FirstOrderDerivative derivative;
+		Timer gradientTimer;
+		double value = evidence.evalDerivative(params, derivative);
+		double gradientTime = gradientTimer.stop();
+		cout<<(ranks[r] == 0? string("exact"): boost::lexical_cast<string>(ranks[r]))
+		<<" "<<trainTime<<" "<<gradientTime
+		<<" "<<loss.eval(test.labels(), model(test.inputs()))<<" "<<value<<endl;
+	}
+}
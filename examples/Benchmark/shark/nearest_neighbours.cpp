@@ -3,7 +3,9 @@
 #include <shark/Models/NearestNeighborClassifier.h>
 #include <shark/Algorithms/NearestNeighbors/TreeNearestNeighbors.h>
 #include <shark/Algorithms/NearestNeighbors/SimpleNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/FlatTreeNearestNeighbors.h>
 #include <shark/Models/Trees/KDTree.h>
+#include <shark/Models/Trees/FlatKDTree.h>
 #include <shark/Models/Kernels/LinearKernel.h>
 
 #include <shark/Core/Timer.h>
@@ -29,6 +31,18 @@ int main(int argc, char **argv) {
 	cout <<  "kdtree: "<< time_taken <<" "<< error<<std::endl;
 	}
 	
+	{
+	Timer time;
+	FlatKDTree flatTree(data.inputs());
+	FlatTreeNearestNeighbors<RealVector,unsigned int> algorithmFlat(data,&flatTree);
+	NearestNeighborClassifier<RealVector> model(&algorithmFlat, 10);
+	ZeroOneLoss<> loss;
+	double error = loss(data.labels(),model(data.inputs()));
+	double time_taken = time.stop();
+		
+	cout <<  "flat kdtree: "<< time_taken <<" "<< error<<std::endl;
+	}
+	
 	{
 	Timer time;
 	LinearKernel<RealVector> euclideanKernel;
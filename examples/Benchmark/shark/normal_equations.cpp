@@ -0,0 +1,53 @@
+#include <shark/Algorithms/Trainers/LinearRegression.h>
+#include <shark/Algorithms/Trainers/LDA.h>
+#include <shark/Algorithms/Trainers/FisherLDA.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//training time of the trainers which accumulate scatter matrices over the dataset
+int main(int argc, char **argv) {
+	std::size_t dimensions[] = {50,200,500};
+	std::size_t numPoints = 50000;
+	std::size_t classes = 10;
+
+	cout<<"d LinearRegression LDA FisherLDA"<<endl;
+	for(std::size_t s = 0; s != 3; ++s){
+		std::size_t d = dimensions[s];
+		std::vector<RealVector> points(numPoints,RealVector(d));
+		std::vector<RealVector> targets(numPoints,RealVector(1));
+		std::vector<unsigned int> labels(numPoints);
+		for(std::size_t i = 0; i != numPoints; ++i){
+			labels[i] = i % classes;
+			for(std::size_t j = 0; j != d; ++j){
+				points[i](j) = Rng::gauss() + (j == labels[i]? 2.0: 0.0);
+			}
+			targets[i](0) = sum(points[i]) + Rng::gauss();
+		}
+		RegressionDataset regression = createLabeledDataFromRange(points,targets,256);
+		ClassificationDataset classification = createLabeledDataFromRange(points,labels,256);
+
+		LinearRegression regressionTrainer;
+		LinearModel<> regressionModel;
+		Timer timeRegression;
+		regressionTrainer.train(regressionModel,regression);
+		double regressionTime = timeRegression.stop();
+
+		LDA ldaTrainer;
+		LinearClassifier<> ldaModel;
+		Timer timeLDA;
+		ldaTrainer.train(ldaModel,classification);
+		double ldaTime = timeLDA.stop();
+
+		FisherLDA fisherTrainer;
+		LinearModel<> fisherModel;
+		Timer timeFisher;
+		fisherTrainer.train(fisherModel,classification);
+		double fisherTime = timeFisher.stop();
+
+		cout<<d<<" "<<regressionTime<<" "<<ldaTime<<" "<<fisherTime<<endl;
+	}
+}
@@ -0,0 +1,48 @@
+#include <shark/Algorithms/Trainers/PCA.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//time of the exact PCA compared to the randomized and the incremental algorithm
+//computing the 10 leading components
+int main(int argc, char **argv) {
+	std::size_t dimensions[] = {100,500,1000};
+	std::size_t numPoints = 10000;
+	std::size_t components = 10;
+
+	cout<<"d standard randomized incremental"<<endl;
+	for(std::size_t s = 0; s != 3; ++s){
+		std::size_t d = dimensions[s];
+		std::vector<RealVector> points(numPoints,RealVector(d));
+		for(auto& point: points){
+			for(std::size_t j = 0; j != d; ++j){
+				point(j) = Rng::gauss() / (j + 1.0);
+			}
+		}
+		UnlabeledData<RealVector> data = createDataFromRange(points,256);
+
+		PCA standard;
+		standard.setAlgorithm(PCA::STANDARD);
+		Timer timeStandard;
+		standard.setData(data);
+		double standardTime = timeStandard.stop();
+
+		PCA randomized;
+		randomized.setAlgorithm(PCA::RANDOMIZED);
+		randomized.setNumberOfComponents(components);
+		Timer timeRandomized;
+		randomized.setData(data);
+		double randomizedTime = timeRandomized.stop();
+
+		PCA incremental;
+		incremental.setNumberOfComponents(components);
+		Timer timeIncremental;
+		incremental.updateData(data);
+		double incrementalTime = timeIncremental.stop();
+
+		cout<<d<<" "<<standardTime<<" "<<randomizedTime<<" "<<incrementalTime<<endl;
+	}
+}
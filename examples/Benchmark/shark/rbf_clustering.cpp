@@ -0,0 +1,61 @@
+#include <shark/Models/Clustering/Centroids.h>
+#include <shark/Models/RBFLayer.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Models/ConcatenatedModel.h>
+#include <shark/ObjectiveFunctions/ErrorFunction.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Algorithms/GradientDescent/Rprop.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//throughput of the soft memberships of Centroids for growing numbers of clusters
+//and the time of training an RBF network with IRprop+
+int main(int argc, char **argv) {
+	std::size_t numPoints = 20000;
+	std::size_t dim = 16;
+	std::size_t ks[] = {10,100,1000};
+
+	std::vector<RealVector> points(numPoints,RealVector(dim));
+	std::vector<RealVector> targets(numPoints,RealVector(1));
+	for(std::size_t i = 0; i != numPoints; ++i){
+		for(std::size_t j = 0; j != dim; ++j){
+			points[i](j) = Rng::gauss();
+		}
+		targets[i](0) = std::sin(sum(points[i]));
+	}
+	Data<RealVector> data = createDataFromRange(points);
+	RegressionDataset dataset(data,createDataFromRange(targets));
+
+	cout<<"k softMembership[patterns/s] rbfTraining[s/iteration]"<<endl;
+	for(std::size_t i = 0; i != 3; ++i){
+		std::size_t k = ks[i];
+		Centroids centroids;
+		centroids.initFromData(data,k);
+		Timer timeMembership;
+		for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+			centroids.softMembership(data.batch(b));
+		}
+		double membershipTime = timeMembership.stop();
+
+		RBFLayer rbf(dim,k);
+		LinearModel<> linear(k,1);
+		ConcatenatedModel<RealVector,RealVector> network = rbf >> linear;
+		initRandomNormal(network,0.1);
+		SquaredLoss<> loss;
+		ErrorFunction error(dataset,&network,&loss);
+		IRpropPlus optimizer;
+		optimizer.init(error);
+		std::size_t iterations = 10;
+		Timer timeTraining;
+		for(std::size_t t = 0; t != iterations; ++t){
+			optimizer.step(error);
+		}
+		double trainingTime = timeTraining.stop();
+
+		cout<<k<<" "<<numPoints/membershipTime<<" "<<trainingTime/iterations<<endl;
+	}
+}
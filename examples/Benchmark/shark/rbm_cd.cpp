@@ -0,0 +1,62 @@
+#include <shark/Unsupervised/RBM/BinaryRBM.h>
+#include <shark/Unsupervised/RBM/Problems/MNIST.h>
+#include <shark/Unsupervised/RBM/StateSpaces/PackedBinaryStates.h>
+#include <shark/Algorithms/GradientDescent/SteepestDescent.h>
+
+#include <shark/Core/Timer.h>
+#include <iostream>
+using namespace shark;
+using namespace std;
+
+//measures the throughput of CD-k on binarized MNIST in samples per second
+//and compares the bit-packed product W*h to the dense product.
+int main(int argc, char **argv) {
+	std::string filename = argc > 1? argv[1] : "train-images-idx3-ubyte";
+	MNIST mnist(filename,127,256);
+	UnlabeledData<RealVector> data = mnist.data();
+	std::size_t numberOfHidden = 500;
+
+	for(unsigned int k = 1; k <= 10; k *= 10){
+		BinaryRBM rbm(Rng::globalRng);
+		rbm.setStructure(mnist.inputDimension(),numberOfHidden);
+		initRandomUniform(rbm,-0.01,0.01);
+		BinaryCD cd(&rbm);
+		cd.setK(k);
+		cd.setData(data);
+		SteepestDescent optimizer;
+		optimizer.setLearningRate(0.01);
+		optimizer.init(cd);
+
+		Timer time;
+		optimizer.step(cd);
+		double time_taken = time.stop();
+		cout << "CD-"<< k << ": " << time_taken << " " << data.numberOfElements()/time_taken << " samples/s" << endl;
+	}
+
+	//input of the visible units given a batch of sampled hidden states
+	BinaryRBM rbm(Rng::globalRng);
+	rbm.setStructure(mnist.inputDimension(),numberOfHidden);
+	initRandomUniform(rbm,-0.01,0.01);
+	RealMatrix hidden(256,numberOfHidden);
+	for(std::size_t i = 0; i != hidden.size1(); ++i){
+		for(std::size_t j = 0; j != hidden.size2(); ++j){
+			hidden(i,j) = Rng::coinToss(0.1);
+		}
+	}
+	RealMatrix input(256,mnist.inputDimension());
+	{
+		Timer time;
+		for(std::size_t rep = 0; rep != 100; ++rep){
+			noalias(input) = prod(hidden,rbm.weightMatrix());
+		}
+		cout << "dense W*h: " << time.stop() << endl;
+	}
+	{
+		Timer time;
+		for(std::size_t rep = 0; rep != 100; ++rep){
+			PackedBinaryMatrix packed(hidden);
+			packedProd(packed,rbm.weightMatrix(),input);
+		}
+		cout << "packed W*h: " << time.stop() << endl;
+	}
+}
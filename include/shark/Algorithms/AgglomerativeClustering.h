@@ -0,0 +1,96 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Agglomerative hierarchical clustering.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2016 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+
+#ifndef SHARK_ALGORITHMS_AGGLOMERATIVECLUSTERING_H
+#define SHARK_ALGORITHMS_AGGLOMERATIVECLUSTERING_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Data/Dataset.h>
+#include <vector>
+
+
+namespace shark{
+
+/// \brief Distance between two clusters used for agglomerative clustering.
+enum AgglomerativeLinkage{
+	SingleLinkage,   ///< smallest distance between points of the two clusters
+	CompleteLinkage, ///< largest distance between points of the two clusters
+	AverageLinkage,  ///< average distance between points of the two clusters
+	WardLinkage      ///< increase of the within-cluster variance, sqrt(2|A||B|/(|A|+|B|)) times the distance of the centroids
+};
+
+/// \brief Merge of two clusters during agglomerative clustering.
+///
+/// The n points of the dataset are the clusters 0,...,n-1. The cluster
+/// created by the i-th merge has the index n+i.
+struct ClusterMerge{
+	std::size_t left;  ///< index of the first merged cluster
+	std::size_t right; ///< index of the second merged cluster
+	double distance;   ///< linkage distance of the two clusters
+	std::size_t size;  ///< number of points in the merged cluster
+};
+
+///
+/// \brief Agglomerative hierarchical clustering.
+///
+/// \par
+/// Starting with every point as its own cluster, the two closest clusters are merged
+/// until a single cluster remains. The distances between points are euclidean.
+/// The n-1 merges are returned sorted by ascending distance, the same format as
+/// the linkage matrix of other libraries. The result can be turned into a clustering model
+/// using the AgglomerativeTree.
+///
+/// \par
+/// All linkages take O(n^2) time. Single linkage uses the SLINK algorithm and Ward linkage
+/// the nearest-neighbor chain algorithm on cluster centroids, both with O(n) memory and distances
+/// computed on demand. Complete and average linkage use the nearest-neighbor chain algorithm
+/// on the matrix of pairwise distances, which needs O(n^2) memory.
+/// The distance computations are performed in parallel.
+///
+/// \par
+/// The algorithms are described in
+/// R. Sibson: SLINK: an optimally efficient algorithm for the single-link cluster method. The Computer Journal, 1973, and
+/// D. Muellner: Modern hierarchical, agglomerative clustering algorithms. arXiv:1109.2378, 2011.
+///
+/// \param data     vector-valued data to be clustered
+/// \param linkage  distance between clusters
+/// \return         the merges sorted by ascending distance
+///
+SHARK_EXPORT_SYMBOL std::vector<ClusterMerge> agglomerativeClustering(
+	Data<RealVector> const& data, AgglomerativeLinkage linkage
+);
+
+} // namespace shark
+#endif
@@ -61,8 +61,19 @@ namespace shark{
 /// \par
 /// This implementation starts the search with the given centroids,
 /// in case the provided centroids object (third parameter) contains
-/// a set of k centroids. Otherwise the search starts from the first
-/// k data points.
+/// a set of k centroids. Otherwise the centroids are initialized
+/// with initKMeansParallel.
+///
+/// \par
+/// The iterations are the ones of Lloyd's algorithm, accelerated by
+/// Hamerly's bounds: for every point an upper bound on the distance to
+/// its centroid and a lower bound on the distance to all other centroids
+/// are maintained using the triangle inequality. Only for points where
+/// the bounds do not exclude a change of the cluster, the distances to all
+/// centroids are computed, as one matrix product per batch. The batches
+/// are processed in parallel. Compared to Elkan's algorithm, which keeps
+/// one lower bound per point and centroid, the memory stays linear in
+/// the number of points.
 ///
 /// \par
 /// Note that the data set needs to include at least k data points
@@ -77,6 +88,84 @@ namespace shark{
 ///
 SHARK_EXPORT_SYMBOL std::size_t kMeans(Data<RealVector> const& data, std::size_t k, Centroids& centroids, std::size_t maxIterations = 0);
 
+///
+/// \brief k-means++ initialization of the centroids.
+///
+/// \par
+/// The first centroid is a random point of the dataset. Every further
+/// centroid is drawn from the points with probability proportional to the
+/// squared distance to the closest centroid chosen so far. This requires
+/// k passes over the dataset.
+///
+/// \param data       vector-valued data to be clustered
+/// \param k          number of clusters
+/// \param centroids  output, the initial centroids
+///
+SHARK_EXPORT_SYMBOL void initKMeansPlusPlus(Data<RealVector> const& data, std::size_t k, Centroids& centroids);
+
+///
+/// \brief k-means|| initialization of the centroids.
+///
+/// \par
+/// Scalable variant of k-means++ which requires only a few passes over the data.
+/// Starting with a random point, in every round each point is sampled independently
+/// with probability oversampling*d(x)^2/sum_x d(x)^2, where d(x) is the distance to the closest
+/// point sampled so far. Finally, each sampled point is weighted by the number
+/// of points closest to it and k centroids are chosen from the weighted sample using k-means++.
+/// The distances are computed batch-wise in parallel.
+///
+/// \par
+/// The method is described in B. Bahmani, B. Moseley, A. Vattani, R. Kumar, S. Vassilvitskii:
+/// Scalable K-Means++. Proceedings of the VLDB Endowment, 2012.
+///
+/// \param data          vector-valued data to be clustered
+/// \param k             number of clusters
+/// \param centroids     output, the initial centroids
+/// \param rounds        number of sampling rounds
+/// \param oversampling  expected number of points sampled per round; 0: 2k
+///
+SHARK_EXPORT_SYMBOL void initKMeansParallel(
+	Data<RealVector> const& data, std::size_t k, Centroids& centroids,
+	std::size_t rounds = 5, double oversampling = 0
+);
+
+///
+/// \brief Mini-batch k-means.
+///
+/// \par
+/// Instead of assigning all points in every iteration, in every iteration
+/// a random batch of the dataset is assigned to the closest centroids
+/// and the centroids are moved towards the assigned points with learning rate
+/// one over the number of points the centroid has been assigned so far.
+/// The result is approximate, but an iteration costs only the assignment of one batch.
+/// If the centroids object does not contain k centroids, it is initialized
+/// with initKMeansParallel.
+///
+/// \par
+/// The method is described in D. Sculley: Web-Scale K-Means Clustering. WWW, 2010.
+///
+/// \param data        vector-valued data to be clustered
+/// \param k           number of clusters
+/// \param centroids   centroids input/output
+/// \param iterations  number of batches used for updates
+///
+SHARK_EXPORT_SYMBOL void miniBatchKMeans(Data<RealVector> const& data, std::size_t k, Centroids& centroids, std::size_t iterations);
+
+///
+/// \brief One step of mini-batch k-means on a batch of points, e.g. from a stream.
+///
+/// \par
+/// The points are assigned to the closest centroids and every centroid
+/// is moved towards each assigned point with learning rate 1/counts(c), after counts(c)
+/// was incremented. If counts does not have as many entries as there are centroids,
+/// it is reset to zero.
+///
+/// \param batch      the points, one per row
+/// \param centroids  centroids input/output
+/// \param counts     number of points assigned to each centroid so far, input/output
+///
+SHARK_EXPORT_SYMBOL void miniBatchKMeansUpdate(RealMatrix const& batch, Centroids& centroids, RealVector& counts);
+
 ///
 /// \brief The k-means clustering algorithm for initializing an RBF Layer
 ///
@@ -0,0 +1,88 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Batched nearest neighbor queries using a FlatKDTree.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_NEARESTNEIGHBORS_FLATTREENEARESTNEIGHBORS_H
+#define SHARK_ALGORITHMS_NEARESTNEIGHBORS_FLATTREENEARESTNEIGHBORS_H
+
+#include <shark/Algorithms/NearestNeighbors/AbstractNearestNeighbors.h>
+#include <shark/Models/Trees/FlatKDTree.h>
+#include <shark/Data/DataView.h>
+
+namespace shark {
+
+///\brief Nearest neighbor search using a FlatKDTree
+///
+///Returns the labels and euclidean distances of the k nearest neighbors of a batch of points.
+///In contrast to the TreeNearestNeighbors, which query one point after another with an
+///IterativeNNQuery, the whole batch is handed to the tree and processed in parallel.
+///The tree must have been built from the inputs of the dataset and must outlive this object.
+template<class InputType, class LabelType>
+class FlatTreeNearestNeighbors:public AbstractNearestNeighbors<InputType,LabelType>{
+private:
+	typedef AbstractNearestNeighbors<InputType,LabelType> base_type;
+public:
+	typedef LabeledData<InputType, LabelType> Dataset;
+	typedef FlatKDTree Tree;
+	typedef typename base_type::DistancePair DistancePair;
+	typedef typename Batch<InputType>::type BatchInputType;
+
+	FlatTreeNearestNeighbors(Dataset const& dataset, Tree const* tree)
+	: m_dataset(dataset), m_labels(m_dataset.labels()), mep_tree(tree){
+		SIZE_CHECK(tree->size() == dataset.numberOfElements());
+	}
+
+	///\brief returns the k nearest neighbors of the points in the batch
+	std::vector<DistancePair> getNeighbors(BatchInputType const& patterns, std::size_t k)const{
+		std::vector<FlatKDTree::DistancePair> neighbors = mep_tree->kNearest(patterns, k);
+		std::vector<DistancePair> results(neighbors.size());
+		for(std::size_t i = 0; i != neighbors.size(); ++i){
+			results[i].key = neighbors[i].key;
+			results[i].value = m_labels[neighbors[i].value];
+		}
+		return results;
+	}
+
+	/// \brief Direct access to the underlying data set of nearest neighbor points.
+	LabeledData<InputType,LabelType>const& dataset()const {
+		return m_dataset;
+	}
+
+private:
+	Dataset m_dataset;                          ///< data set of nearest neighbor points
+	DataView<Data<LabelType> const> m_labels;   ///< random access to the labels
+	Tree const* mep_tree;                       ///< tree built from the inputs of the dataset
+};
+
+}
+#endif
@@ -0,0 +1,411 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Hierarchical navigable small world graph for approximate nearest neighbor search.
+ *
+ *
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_NEARESTNEIGHBORS_HNSWGRAPH_H
+#define SHARK_ALGORITHMS_NEARESTNEIGHBORS_HNSWGRAPH_H
+
+#include <shark/Data/Dataset.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/ISerializable.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Core/utility/KeyValuePair.h>
+#include <shark/Rng/GlobalRng.h>
+#include <boost/serialization/vector.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace shark {
+
+///
+/// \brief Hierarchical navigable small world (HNSW) graph for approximate nearest neighbor search.
+///
+/// \par
+/// The graph consists of several layers. Every point is assigned a random top layer, where the probability of
+/// being present in a layer decreases exponentially with the layer index. In each layer a point is connected
+/// to at most maxNeighbors() other points, on the bottom layer to at most twice as many. A query descends greedily
+/// from the top layer to the bottom layer, where a best-first search keeps the ef closest points seen so far.
+/// Larger values of ef increase the recall at the expense of query time. Unlike the trees, the
+/// search time grows only slowly with the dimensionality of the data, which makes the graph suitable for
+/// high-dimensional inputs, for example embeddings.
+///
+/// \par
+/// The points are copied into the graph. The graph is built by inserting the points in batches:
+/// the searches for the neighbors of the points of a batch are performed in parallel on the graph built so far,
+/// afterwards the new edges are added and the neighbor lists which became too long are pruned in parallel.
+/// The batches are small compared to the graph, so that the points of a batch rarely are neighbors of each other.
+///
+/// \par
+/// The distances are euclidean. The method is described in
+/// Yu. A. Malkov, D. A. Yashunin: Efficient and robust approximate nearest neighbor search using
+/// Hierarchical Navigable Small World graphs. IEEE TPAMI, 2018.
+///
+class HNSWGraph : public ISerializable{
+public:
+	typedef KeyValuePair<double,std::size_t> DistancePair;
+
+	/// \brief Default constructor creating an empty graph, used for deserialization.
+	HNSWGraph():m_maxNeighbors(16), m_efConstruction(200), m_entryPoint(0), m_maxLevel(0){}
+
+	/// \brief Construct the graph from data.
+	///
+	/// The top layers of the points are drawn using the global random number generator.
+	///
+	/// \param  dataset         the points to be stored in the graph
+	/// \param  maxNeighbors    maximum number of neighbors of a point in the upper layers, the bottom layer allows twice as many
+	/// \param  efConstruction  number of candidates kept during the search for the neighbors of a new point
+	template<class InputType>
+	HNSWGraph(Data<InputType> const& dataset, std::size_t maxNeighbors = 16, std::size_t efConstruction = 200)
+	:m_maxNeighbors(maxNeighbors), m_efConstruction(efConstruction), m_entryPoint(0), m_maxLevel(0){
+		SHARK_CHECK(maxNeighbors > 1, "[HNSWGraph] maxNeighbors must be at least 2");
+		std::size_t n = dataset.numberOfElements();
+		SHARK_CHECK(n > 0, "[HNSWGraph] can not build a graph from an empty dataset");
+
+		m_points.resize(n,dataDimension(dataset));
+		std::size_t start = 0;
+		for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+			typename Batch<InputType>::type const& batch = dataset.batch(b);
+			std::size_t batchSize = shark::size(batch);
+			noalias(rows(m_points,start,start+batchSize)) = batch;
+			start += batchSize;
+		}
+		build();
+	}
+
+	/// \brief Number of points stored in the graph.
+	std::size_t size()const{
+		return m_points.size1();
+	}
+
+	/// \brief Dimensionality of the points.
+	std::size_t dimension()const{
+		return m_points.size2();
+	}
+
+	/// \brief Maximum number of neighbors of a point in the upper layers.
+	std::size_t maxNeighbors()const{
+		return m_maxNeighbors;
+	}
+
+	/// \brief Number of candidates kept during construction.
+	std::size_t efConstruction()const{
+		return m_efConstruction;
+	}
+
+	/// \brief Number of layers of the graph.
+	std::size_t numberOfLayers()const{
+		return m_maxLevel + 1;
+	}
+
+	/// \brief Index of the top layer of point i.
+	std::size_t level(std::size_t i)const{
+		return m_neighbors[i].size() - 1;
+	}
+
+	/// \brief Indices of the neighbors of point i in the given layer.
+	std::vector<std::size_t> const& neighbors(std::size_t i, std::size_t layer)const{
+		return m_neighbors[i][layer];
+	}
+
+	/// \brief The stored points.
+	RealMatrix const& points()const{
+		return m_points;
+	}
+
+	/// \brief Computes the approximate k nearest neighbors of every row of the query matrix.
+	///
+	/// The result is a linearized array of size queries.size1()*k: the first k entries are
+	/// the neighbors of the first query sorted by distance, the next k the neighbors of the second query and so on.
+	/// The key of each entry is the euclidean distance, the value the index of the point in the original dataset.
+	/// The queries are processed in parallel.
+	///
+	/// \param queries  the query points, one per row
+	/// \param k        number of neighbors
+	/// \param ef       number of candidates kept during the search. Values smaller than k are increased to k.
+	template<class QueryMatrix>
+	std::vector<DistancePair> kNearest(
+		blas::matrix_expression<QueryMatrix, blas::cpu_tag> const& queries, std::size_t k, std::size_t ef
+	)const{
+		SIZE_CHECK(queries().size2() == dimension());
+		if(k > size())
+			throw SHARKEXCEPTION("[HNSWGraph::kNearest] k is larger than the number of points");
+		ef = std::max(ef,k);
+		RealMatrix queryMatrix = queries();//dense copy so that rows can be accessed quickly
+		std::size_t numQueries = queryMatrix.size1();
+		std::vector<DistancePair> results(numQueries * k);
+
+		std::vector<SearchBuffer> buffers(SHARK_NUM_THREADS, SearchBuffer(size()));
+		SHARK_PARALLEL_FOR(int q = 0; q < (int)numQueries; ++q){
+			SearchBuffer& buffer = buffers[SHARK_THREAD_NUM];
+			double const* query = &queryMatrix(q,0);
+			std::vector<DistancePair> entry(1,DistancePair(distanceSqr(query, m_entryPoint), m_entryPoint));
+			for(std::size_t layer = m_maxLevel; layer > 0; --layer){
+				searchLayer(query, entry, 1, layer, buffer);
+			}
+			searchLayer(query, entry, ef, 0, buffer);
+			//if the search got stuck in a small part of the graph, the missing neighbors are reported at infinite distance
+			for(std::size_t i = 0; i != k; ++i){
+				if(i < entry.size()){
+					results[q * k + i].key = std::sqrt(entry[i].key);
+					results[q * k + i].value = entry[i].value;
+				}else{
+					results[q * k + i].key = std::numeric_limits<double>::infinity();
+					results[q * k + i].value = entry.back().value;
+				}
+			}
+		}
+		return results;
+	}
+
+	/// \brief Reads the graph from an archive.
+	void read(InArchive& archive){
+		archive >> m_points;
+		archive >> m_neighbors;
+		archive >> m_maxNeighbors;
+		archive >> m_efConstruction;
+		archive >> m_entryPoint;
+		archive >> m_maxLevel;
+	}
+
+	/// \brief Writes the graph to an archive.
+	void write(OutArchive& archive) const{
+		archive << m_points;
+		archive << m_neighbors;
+		archive << m_maxNeighbors;
+		archive << m_efConstruction;
+		archive << m_entryPoint;
+		archive << m_maxLevel;
+	}
+
+private:
+	///\brief Memory of a search that is reused for all searches of a thread.
+	///
+	///A point is visited in the current search, if its entry in visited equals the epoch of the search.
+	struct SearchBuffer{
+		SearchBuffer(std::size_t n):visited(n,0), epoch(0){}
+		std::vector<unsigned int> visited;
+		unsigned int epoch;
+		std::vector<DistancePair> candidates;
+		std::vector<DistancePair> results;
+	};
+
+	///\brief Maximum number of neighbors in a layer.
+	std::size_t maxNeighbors(std::size_t layer)const{
+		return layer == 0? 2 * m_maxNeighbors: m_maxNeighbors;
+	}
+
+	///\brief Squared euclidean distance between a point and a stored point.
+	double distanceSqr(double const* point, std::size_t i)const{
+		double const* stored = &m_points(i,0);
+		double dist = 0;
+		for(std::size_t j = 0; j != dimension(); ++j){
+			double diff = point[j] - stored[j];
+			dist += diff * diff;
+		}
+		return dist;
+	}
+
+	///\brief Best-first search in one layer.
+	///
+	///On entry, points holds the entry points of the search with their squared distances to the query.
+	///On exit, it holds the ef closest points found sorted by ascending distance.
+	void searchLayer(
+		double const* query, std::vector<DistancePair>& points,
+		std::size_t ef, std::size_t layer, SearchBuffer& buffer
+	)const{
+		++buffer.epoch;
+		if(buffer.epoch == 0){//overflow, reset the marks
+			std::fill(buffer.visited.begin(), buffer.visited.end(), 0);
+			buffer.epoch = 1;
+		}
+		//candidates is a min-heap of points to expand, results a max-heap of the best points so far
+		std::vector<DistancePair>& candidates = buffer.candidates;
+		std::vector<DistancePair>& results = buffer.results;
+		candidates.clear();
+		results.clear();
+		for(std::size_t i = 0; i != points.size(); ++i){
+			buffer.visited[points[i].value] = buffer.epoch;
+			candidates.push_back(points[i]);
+			std::push_heap(candidates.begin(), candidates.end(), std::greater<DistancePair>());
+			results.push_back(points[i]);
+			std::push_heap(results.begin(), results.end());
+			if(results.size() > ef){
+				std::pop_heap(results.begin(), results.end());
+				results.pop_back();
+			}
+		}
+
+		while(!candidates.empty()){
+			std::pop_heap(candidates.begin(), candidates.end(), std::greater<DistancePair>());
+			DistancePair current = candidates.back();
+			candidates.pop_back();
+			if(current.key > results.front().key) break;
+
+			std::vector<std::size_t> const& edges = m_neighbors[current.value][layer];
+			for(std::size_t e = 0; e != edges.size(); ++e){
+				std::size_t neighbor = edges[e];
+				if(buffer.visited[neighbor] == buffer.epoch) continue;
+				buffer.visited[neighbor] = buffer.epoch;
+				double dist = distanceSqr(query, neighbor);
+				if(results.size() < ef || dist < results.front().key){
+					candidates.push_back(DistancePair(dist,neighbor));
+					std::push_heap(candidates.begin(), candidates.end(), std::greater<DistancePair>());
+					results.push_back(DistancePair(dist,neighbor));
+					std::push_heap(results.begin(), results.end());
+					if(results.size() > ef){
+						std::pop_heap(results.begin(), results.end());
+						results.pop_back();
+					}
+				}
+			}
+		}
+		std::sort_heap(results.begin(), results.end());
+		points = results;
+	}
+
+	///\brief Selects the neighbors of a point from candidates sorted by ascending distance.
+	///
+	///A candidate is preferred if it is closer to the point than to all neighbors selected before,
+	///which keeps edges in different directions. Remaining slots are filled with the closest discarded candidates.
+	void selectNeighbors(
+		std::vector<DistancePair> const& candidates, std::size_t maxNeighbors, std::vector<std::size_t>& selected
+	)const{
+		selected.clear();
+		std::vector<std::size_t> discarded;
+		for(std::size_t c = 0; c != candidates.size() && selected.size() != maxNeighbors; ++c){
+			std::size_t candidate = candidates[c].value;
+			bool good = true;
+			for(std::size_t s = 0; s != selected.size(); ++s){
+				if(distanceSqr(&m_points(candidate,0), selected[s]) < candidates[c].key){
+					good = false;
+					break;
+				}
+			}
+			if(good)
+				selected.push_back(candidate);
+			else
+				discarded.push_back(candidate);
+		}
+		for(std::size_t d = 0; d != discarded.size() && selected.size() != maxNeighbors; ++d){
+			selected.push_back(discarded[d]);
+		}
+	}
+
+	///\brief Builds the graph from the stored points.
+	void build(){
+		std::size_t n = size();
+		//draw the top layer of every point
+		double levelScale = 1.0 / std::log(double(m_maxNeighbors));
+		m_neighbors.assign(n, std::vector<std::vector<std::size_t> >());
+		for(std::size_t i = 0; i != n; ++i){
+			std::size_t topLayer = (std::size_t)(-std::log(1.0 - Rng::uni(0,1)) * levelScale);
+			m_neighbors[i].resize(topLayer + 1);
+		}
+		m_entryPoint = 0;
+		m_maxLevel = level(0);
+
+		std::size_t maxBatchSize = 64 * SHARK_NUM_THREADS;
+		std::vector<SearchBuffer> buffers(SHARK_NUM_THREADS, SearchBuffer(n));
+		std::size_t inserted = 1;
+		while(inserted != n){
+			std::size_t batchSize = std::min(std::min(inserted, maxBatchSize), n - inserted);
+			std::size_t batchStart = inserted;
+
+			//search the neighbors of the new points in the current graph. The new points
+			//are not reachable yet, thus every thread only writes its own neighbor lists
+			SHARK_PARALLEL_FOR(int p = 0; p < (int)batchSize; ++p){
+				SearchBuffer& buffer = buffers[SHARK_THREAD_NUM];
+				std::size_t point = batchStart + p;
+				double const* query = &m_points(point,0);
+				std::vector<DistancePair> entry(1,DistancePair(distanceSqr(query, m_entryPoint), m_entryPoint));
+				std::size_t pointLevel = level(point);
+				for(std::size_t layer = m_maxLevel; layer > pointLevel; --layer){
+					searchLayer(query, entry, 1, layer, buffer);
+				}
+				for(std::size_t layer = std::min(pointLevel, m_maxLevel) + 1; layer-- > 0;){
+					searchLayer(query, entry, m_efConstruction, layer, buffer);
+					selectNeighbors(entry, maxNeighbors(layer), m_neighbors[point][layer]);
+				}
+			}
+
+			//add the reverse edges and remember the lists which became too long
+			std::vector<std::pair<std::size_t,std::size_t> > overfull;
+			for(std::size_t point = batchStart; point != batchStart + batchSize; ++point){
+				for(std::size_t layer = 0; layer != m_neighbors[point].size(); ++layer){
+					std::vector<std::size_t> const& edges = m_neighbors[point][layer];
+					for(std::size_t e = 0; e != edges.size(); ++e){
+						std::vector<std::size_t>& reverse = m_neighbors[edges[e]][layer];
+						reverse.push_back(point);
+						if(reverse.size() == maxNeighbors(layer) + 1)
+							overfull.push_back(std::make_pair(edges[e], layer));
+					}
+				}
+			}
+
+			//prune the overfull lists, every list is owned by one iteration
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)overfull.size(); ++i){
+				std::size_t point = overfull[i].first;
+				std::size_t layer = overfull[i].second;
+				std::vector<std::size_t>& edges = m_neighbors[point][layer];
+				std::vector<DistancePair> candidates(edges.size());
+				for(std::size_t e = 0; e != edges.size(); ++e){
+					candidates[e] = DistancePair(distanceSqr(&m_points(point,0), edges[e]), edges[e]);
+				}
+				std::sort(candidates.begin(), candidates.end());
+				selectNeighbors(candidates, maxNeighbors(layer), edges);
+			}
+
+			//points with a higher top layer become the new entry point
+			for(std::size_t point = batchStart; point != batchStart + batchSize; ++point){
+				if(level(point) > m_maxLevel){
+					m_maxLevel = level(point);
+					m_entryPoint = point;
+				}
+			}
+			inserted += batchSize;
+		}
+	}
+
+	RealMatrix m_points;                                             ///< the stored points
+	std::vector<std::vector<std::vector<std::size_t> > > m_neighbors;///< neighbors of every point in every layer of the point
+	std::size_t m_maxNeighbors;                                      ///< maximum number of neighbors in the upper layers
+	std::size_t m_efConstruction;                                    ///< number of candidates kept during construction
+	std::size_t m_entryPoint;                                        ///< point in the top layer where every search starts
+	std::size_t m_maxLevel;                                          ///< index of the top layer
+};
+
+}
+#endif
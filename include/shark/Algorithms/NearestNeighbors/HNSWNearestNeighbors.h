@@ -0,0 +1,100 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Approximate nearest neighbor queries using a HNSWGraph.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_NEARESTNEIGHBORS_HNSWNEARESTNEIGHBORS_H
+#define SHARK_ALGORITHMS_NEARESTNEIGHBORS_HNSWNEARESTNEIGHBORS_H
+
+#include <shark/Algorithms/NearestNeighbors/AbstractNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/HNSWGraph.h>
+#include <shark/Data/DataView.h>
+
+namespace shark {
+
+///\brief Approximate nearest neighbor search using a HNSWGraph
+///
+///Returns the labels and euclidean distances of approximately the k nearest neighbors of a batch of points.
+///The trade-off between recall and query time is controlled by the search width ef,
+///the number of candidates kept during the search in the bottom layer of the graph.
+///The graph must have been built from the inputs of the dataset and must outlive this object.
+template<class InputType, class LabelType>
+class HNSWNearestNeighbors:public AbstractNearestNeighbors<InputType,LabelType>{
+private:
+	typedef AbstractNearestNeighbors<InputType,LabelType> base_type;
+public:
+	typedef LabeledData<InputType, LabelType> Dataset;
+	typedef typename base_type::DistancePair DistancePair;
+	typedef typename Batch<InputType>::type BatchInputType;
+
+	HNSWNearestNeighbors(Dataset const& dataset, HNSWGraph const* graph, std::size_t ef = 50)
+	: m_dataset(dataset), m_labels(m_dataset.labels()), mep_graph(graph), m_ef(ef){
+		SIZE_CHECK(graph->size() == dataset.numberOfElements());
+	}
+
+	/// \brief Number of candidates kept during the search.
+	std::size_t ef()const{
+		return m_ef;
+	}
+
+	/// \brief Sets the number of candidates kept during the search.
+	///
+	/// Larger values increase the recall and the query time. Values smaller than k are increased to k.
+	void setEf(std::size_t ef){
+		m_ef = ef;
+	}
+
+	///\brief returns the approximate k nearest neighbors of the points in the batch
+	std::vector<DistancePair> getNeighbors(BatchInputType const& patterns, std::size_t k)const{
+		std::vector<HNSWGraph::DistancePair> neighbors = mep_graph->kNearest(patterns, k, m_ef);
+		std::vector<DistancePair> results(neighbors.size());
+		for(std::size_t i = 0; i != neighbors.size(); ++i){
+			results[i].key = neighbors[i].key;
+			results[i].value = m_labels[neighbors[i].value];
+		}
+		return results;
+	}
+
+	/// \brief Direct access to the underlying data set of nearest neighbor points.
+	LabeledData<InputType,LabelType>const& dataset()const {
+		return m_dataset;
+	}
+
+private:
+	Dataset m_dataset;                          ///< data set of nearest neighbor points
+	DataView<Data<LabelType> const> m_labels;   ///< random access to the labels
+	HNSWGraph const* mep_graph;                 ///< graph built from the inputs of the dataset
+	std::size_t m_ef;                           ///< number of candidates kept during the search
+};
+
+}
+#endif
@@ -38,7 +38,10 @@
 #include <shark/Algorithms/NearestNeighbors/AbstractNearestNeighbors.h>
 #include <shark/Models/Kernels/AbstractMetric.h>
 #include <shark/Core/OpenMP.h>
+#include <boost/range/iterator_range.hpp>
 #include <algorithm>
+#include <functional>
+#include <limits>
 
 
 namespace shark {
@@ -67,51 +70,70 @@ public:
 	:m_dataset(dataset), mep_metric(metric){}
 
 	///\brief Return the k nearest neighbors of the query point.
+	///
+	///The queries are split into blocks and the distances are computed tile-wise between a block of queries
+	///and a batch of the dataset, such that both queries and dataset are distributed over the threads.
+	///Every thread keeps a heap of the k nearest neighbors found so far for every query.
 	std::vector<DistancePair> getNeighbors(BatchInputType const& patterns, std::size_t k)const{
+		typedef typename std::vector<DistancePair>::iterator iterator;
 		std::size_t numPatterns = size(patterns);
-		std::size_t maxThreads = std::min(SHARK_NUM_THREADS,m_dataset.numberOfBatches());
+		std::size_t numBatches = m_dataset.numberOfBatches();
+
+		//split the queries into blocks. Large blocks make the distance computation efficient,
+		//but if the dataset has less batches than threads, we need more blocks to keep all threads busy
+		std::size_t numBlocks = (numPatterns + MaxQueryBlockSize - 1) / MaxQueryBlockSize;
+		numBlocks = std::max(numBlocks, std::min(numPatterns, (SHARK_NUM_THREADS + numBatches - 1) / numBatches));
+		std::size_t blockSize = (numPatterns + numBlocks - 1) / numBlocks;
+		numBlocks = (numPatterns + blockSize - 1) / blockSize;
+		std::vector<BatchInputType> blocks(numBlocks);
+		for(std::size_t block = 0; block != numBlocks; ++block){
+			std::size_t start = block * blockSize;
+			std::size_t end = std::min(start + blockSize, numPatterns);
+			blocks[block] = Batch<InputType>::createBatchFromRange(
+				boost::make_iterator_range(boost::begin(patterns) + start, boost::begin(patterns) + end)
+			);
+		}
+		std::size_t numTiles = numBlocks * numBatches;
+		std::size_t maxThreads = std::min(SHARK_NUM_THREADS,numTiles);
+
 		//heaps of key value pairs (distance,classlabel). One heap for every pattern and thread.
 		//For memory alignment reasons, all heaps are stored in one continuous array
 		//the heaps are stored such, that for every pattern the heaps for every thread
-		//are forming one memory area. so later we can just merge all 4 heaps using make_heap
+		//are forming one memory area. so later we can just merge all heaps using make_heap
 		//be aware that the values created here allready form a heap since they are all
 		//identical maximum distance.
 		std::vector<DistancePair> heaps(k*numPatterns*maxThreads,DistancePair(std::numeric_limits<double>::max(),LabelType()));
-		typedef typename std::vector<DistancePair>::iterator iterator;
-		//iterate over all batches of the training set in parallel and let
-		//every thread do a KNN-Search on it's subset of data
-		SHARK_PARALLEL_FOR(int b = 0; b < (int)m_dataset.numberOfBatches(); ++b){
-			//evaluate distances between the points of the patterns and the batch
-			RealMatrix distances=mep_metric->featureDistanceSqr(patterns,m_dataset.batch(b).input);
-			
-			//now update the heaps with the distances
-			for(std::size_t p = 0; p != numPatterns; ++p){
-				std::size_t batchSize = distances.size2();
-				
-				//get current heap
+		//buffer for the candidates of a row of a tile, one for every thread
+		std::vector<std::vector<DistancePair> > candidates(maxThreads);
+
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numTiles; ++t){
+			std::size_t block = t / numBatches;
+			std::size_t b = t % numBatches;
+			typename LabeledData<InputType,LabelType>::const_batch_reference batch = m_dataset.batch(b);
+			//evaluate distances between the points of the block and the batch
+			RealMatrix distances=mep_metric->featureDistanceSqr(blocks[block],batch.input);
+			std::vector<DistancePair>& rowCandidates = candidates[SHARK_THREAD_NUM];
+
+			for(std::size_t i = 0; i != distances.size1(); ++i){
+				std::size_t p = block * blockSize + i;
 				std::size_t heap = p*maxThreads+SHARK_THREAD_NUM;
 				iterator heapStart=heaps.begin()+heap*k;
 				iterator heapEnd=heapStart+k;
-				iterator biggest=heapEnd-1;//position of biggest element
-				
-				//update heap values using the new distances
-				for(std::size_t i = 0; i != batchSize; ++i){
-					if(biggest->key >= distances(p,i)){
-						//push the smaller neighbor in the heap and replace the biggest one
-						biggest->key=distances(p,i);
-						biggest->value=get(m_dataset.batch(b).label,i);
-						std::push_heap(heapStart,heapEnd);
-						//pop biggest element, so that 
-						//biggest is again the biggest element
-						std::pop_heap(heapStart,heapEnd);
+
+				//only points closer than the current k-th neighbor are candidates
+				double threshold = heapStart->key;
+				rowCandidates.clear();
+				for(std::size_t j = 0; j != distances.size2(); ++j){
+					if(distances(i,j) < threshold){
+						rowCandidates.push_back(DistancePair(distances(i,j),get(batch.label,j)));
 					}
 				}
+				updateHeap(heapStart,heapEnd,rowCandidates);
 			}
 		}
 		std::vector<DistancePair> results(k*numPatterns);
 		//finally, we merge all threads in one heap which has the inverse ordering
 		//and create a class histogram over the smallest k neighbors
-		//std::cout<<"info "<<numPatterns<<" "<<maxThreads<<" "<<k<<std::endl;
 		SHARK_PARALLEL_FOR(int p = 0; p < (int)numPatterns; ++p){
 			//find range of the heaps for all threads
 			iterator heapStart=heaps.begin()+p*maxThreads*k;
@@ -138,6 +160,36 @@ public:
 	}
 
 private:
+	///\brief Maximum number of queries processed together in one tile.
+	BOOST_STATIC_CONSTANT(std::size_t, MaxQueryBlockSize = 1024);
+
+	///\brief Merges the candidates of a row of a tile into a max-heap of the k nearest neighbors.
+	///
+	///Few candidates are inserted one by one. If there are many, the k smallest of candidates and heap
+	///are selected at once in linear time and the heap is rebuilt.
+	static void updateHeap(
+		typename std::vector<DistancePair>::iterator heapStart,
+		typename std::vector<DistancePair>::iterator heapEnd,
+		std::vector<DistancePair>& candidates
+	){
+		std::size_t k = heapEnd - heapStart;
+		if(candidates.size() * 8 < k){
+			for(std::size_t c = 0; c != candidates.size(); ++c){
+				if(candidates[c].key < heapStart->key){
+					//move the biggest element to the back, replace it and restore the heap
+					std::pop_heap(heapStart,heapEnd);
+					*(heapEnd-1) = candidates[c];
+					std::push_heap(heapStart,heapEnd);
+				}
+			}
+			return;
+		}
+		candidates.insert(candidates.end(),heapStart,heapEnd);
+		std::nth_element(candidates.begin(),candidates.begin()+(k-1),candidates.end());
+		std::copy(candidates.begin(),candidates.begin()+k,heapStart);
+		std::make_heap(heapStart,heapEnd);
+	}
+
 	Dataset m_dataset;                        ///< data set of nearest neighbor points
 	Metric const* mep_metric;                 ///< metric for measuring distances, usually given by a kernel function
 };
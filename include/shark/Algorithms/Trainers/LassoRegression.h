@@ -38,7 +38,10 @@
 
 #include <shark/Models/LinearModel.h>
 #include <shark/Algorithms/Trainers/AbstractTrainer.h>
+#include <shark/Core/IParameterizable.h>
+#include <shark/Core/OpenMP.h>
 #include <cmath>
+#include <vector>
 
 
 namespace shark {
@@ -56,7 +59,13 @@ namespace shark {
  *  the trainer solves the problem
  *  \f$ \min_w \quad \frac{1}{2} \sum_i (w^T x_i - y_i)^2 + \lambda \|w\|_1 \f$.
  *  The target accuracy of the solution is measured in terms of the
- *  smallest component of the gradient of the objective function.
+ *  largest violation of the optimality conditions, i.e. the largest
+ *  component of the (sub-)gradient of the objective function.
+ *
+ *  The problem is solved by coordinate descent as in glmnet (Friedman,
+ *  Hastie and Tibshirani, 2010), using strong rules to discard features
+ *  and active-set cycling. trainPath() computes the solutions for a whole
+ *  sequence of regularization parameters using warm starts.
  *
  *  The trainer has one template parameter, namely the type of
  *  the input vectors \f$ x_i \f$. These need to be vector valued,
@@ -140,198 +149,213 @@ public:
 	{
 		SIZE_CHECK(model.outputSize() == 1);
 
-		// strategy constants
-		const double CHANGE_RATE = 0.2;
-		const double PREF_MIN = 0.05;
-		const double PREF_MAX = 20.0;
+		CoordinateDescent solver(dataset, m_accuracy);
+		solver.solve(m_lambda, solver.lambdaMax());
 
-		// console output
-		const bool verbose = false;
+		// write the weight vector into the model
+		RealMatrix mat(1, solver.weights().size());
+		row(mat, 0) = solver.weights();
+		model.setStructure(mat);
+	}
 
-		std::size_t dim = inputDimension(dataset);
-		RealVector w(dim, 0.0);
+	/// \brief Returns a regularization path of logarithmically spaced values.
+	///
+	/// The path starts at the smallest value of lambda for which all weights are zero,
+	/// \f$ \lambda_{\max} = \max_j |\sum_i x_{i,j} y_i| \f$, and ends at ratio times this value.
+	RealVector lambdaPath(DataType const& dataset, std::size_t numLambdas = 100, double ratio = 1.e-3) const
+	{
+		SIZE_CHECK(numLambdas > 0);
+		RANGE_CHECK(ratio > 0.0 && ratio <= 1.0);
+		CoordinateDescent solver(dataset, m_accuracy);
+		double lambdaMax = solver.lambdaMax();
+		RealVector lambdas(numLambdas, lambdaMax);
+		for(std::size_t k = 1; k < numLambdas; ++k){
+			lambdas(k) = lambdaMax * std::pow(ratio, double(k) / (numLambdas - 1));
+		}
+		return lambdas;
+	}
 
+	/// \brief Computes the solutions for a whole path of regularization parameters.
+	///
+	/// The values of lambda must be non-increasing. Every problem is warm-started
+	/// from the solution of the previous one and the strong rule discards most
+	/// features before they are ever looked at, so this is much faster than
+	/// training for every value separately.
+	/// Returns a matrix with the weight vector for lambdas(k) in row k.
+	RealMatrix trainPath(DataType const& dataset, RealVector const& lambdas) const
+	{
+		CoordinateDescent solver(dataset, m_accuracy);
+		RealMatrix path(lambdas.size(), inputDimension(dataset));
+		double previousLambda = solver.lambdaMax();
+		for(std::size_t k = 0; k != lambdas.size(); ++k){
+			RANGE_CHECK(lambdas(k) >= 0.0);
+			SHARK_CHECK(k == 0 || lambdas(k) <= lambdas(k-1), "[LassoRegression::trainPath] lambdas must be non-increasing");
+			solver.solve(lambdas(k), std::max(previousLambda, lambdas(k)));
+			noalias(row(path, k)) = solver.weights();
+			previousLambda = lambdas(k);
+		}
+		return path;
+	}
+
+protected:
+	/// \brief Coordinate descent solver in the style of glmnet.
+	///
+	/// The gradient of the quadratic part w.r.t. feature j is \f$ g_j = x_j^T(Xw-y) \f$,
+	/// where \f$ x_j \f$ is the j-th feature over all points. It is either computed from the
+	/// residual \f$ r = Xw-y \f$ (naive mode, used when there are more features than points) or,
+	/// if there are more points than features, maintained for all features using the columns
+	/// \f$ X^T x_k \f$ of the covariance matrix which are computed once when feature k first
+	/// becomes nonzero. Then the cost of an update does not depend on the number of points
+	/// and the KKT conditions of all features can be checked for free.
+	///
+	/// For every lambda, the strong rule restricts the optimization to the features
+	/// with \f$ |g_j| \geq 2 \lambda - \lambda_{prev} \f$ and the nonzero weights. The
+	/// problem is solved on this set by cycling over the nonzero weights and
+	/// only occasionally sweeping over the full set. Afterwards the KKT conditions are
+	/// checked for the remaining features in parallel, violators are added to the set.
+	class CoordinateDescent{
+	public:
 		// transpose the dataset and push it inside a single matrix
-		typename Batch<InputVectorType>::type data = trans(createBatch(dataset.inputs().elements()));
-		RealVector label = column(createBatch(dataset.labels().elements()),0);
+		CoordinateDescent(DataType const& dataset, double accuracy)
+		: m_data(trans(createBatch(dataset.inputs().elements())))
+		, m_accuracy(accuracy){
+			RealVector label = column(createBatch(dataset.labels().elements()),0);
+			std::size_t dim = m_data.size1();
+			std::size_t points = m_data.size2();
+			m_covarianceMode = points > dim && dim <= MaxCovarianceDimensions;
+
+			m_weights = RealVector(dim, 0.0);
+			m_diag.resize(dim);
+			m_gradient.resize(dim);
+			m_residual = -label;
+			// pre-calculate diagonal matrix entries (feature-wise squared norms) and the gradient at w=0
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)dim; ++i){
+				m_diag(i) = norm_sqr(row(m_data,i));
+				m_gradient(i) = inner_prod(m_residual, row(m_data,i));
+			}
+			if(m_covarianceMode)
+				m_covarianceColumns.resize(dim);
+			m_lambdaMax = dim > 0? norm_inf(m_gradient) : 0.0;
+		}
 
-		RealVector diag(dim);
-		RealVector difference = -label;
-		UIntVector index(dim);
+		/// smallest lambda for which the solution is zero
+		double lambdaMax() const{
+			return m_lambdaMax;
+		}
 
-		// pre-calculate diagonal matrix entries (feature-wise squared norms)
-		for (size_t i=0; i<dim; i++){
-			diag[i] = norm_sqr(row(data,i));
+		RealVector const& weights() const{
+			return m_weights;
 		}
 
-		// prepare preferences for scheduling
-		RealVector pref(dim, 1.0);
-		double prefsum = (double)dim;
-
-		// prepare performance monitoring for self-adaptation
-		const double gain_learning_rate = 1.0 / dim;
-		double average_gain = 0.0;
-		bool canstop = true;
-		const double lambda = m_lambda;
-
-		// main optimization loop
-		std::size_t iter = 0;
-		std::size_t steps = 0;
-		while (true)
-		{
-			double maxvio = 0.0;
-
-			// define schedule
-			double psum = prefsum;
-			prefsum = 0.0;
-			int pos = 0;
-
-			for (std::size_t i=0; i<dim; i++)
-			{
-				double p = pref[i];
-				double n;
-				if (psum >= 1e-6 && p < psum) 
-					n = (dim - pos) * p / psum;
-				else 
-					n = (dim - pos);                // for numerical stability
-
-				unsigned int m = (unsigned int)floor(n);
-				double prob = n - m;
-				if ((double)rand() / (double)RAND_MAX < prob) m++;
-				for (std::size_t  j=0; j<m; j++)
-				{
-					index[pos] = (unsigned int)i;
-					pos++;
+		/// solves the problem for lambda, starting from the current weights which solve the problem for previousLambda
+		void solve(double lambda, double previousLambda){
+			std::size_t dim = m_weights.size();
+			// strong rule screening
+			std::vector<std::size_t> strongSet;
+			std::vector<char> isStrong(dim, 0);
+			for(std::size_t j = 0; j != dim; ++j){
+				if(m_weights(j) != 0.0 || std::abs(m_gradient(j)) >= 2 * lambda - previousLambda){
+					strongSet.push_back(j);
+					isStrong[j] = 1;
 				}
-				psum -= p;
-				prefsum += p;
 			}
-			for (std::size_t i=0; i<dim; i++)
-			{
-				std::size_t r = rand() % dim;
-				std::swap(index[r], index[i]);
-			}
-
-			steps += dim;
-			for (size_t s=0; s<dim; s++)
-			{
-				std::size_t i = index[s];
-				double a = w[i];
-				double d = diag[i];
-
-				// compute gradient
-				double grad = inner_prod(difference, row(data,i));
-
-				// compute optimal coordinate descent step and corresponding gain
-				double vio = 0.0;
-				double gain = 0.0;
-				double delta = 0.0;
-				if (a == 0.0)
-				{
-					if (grad > lambda)
-					{
-						vio = grad - lambda;
-						delta = -vio / d;
-						gain = 0.5 * d * delta * delta;
+			std::vector<std::size_t> activeSet;
+			while(true){
+				// solve the problem restricted to the strong set
+				while(sweep(strongSet, lambda) > m_accuracy){
+					// cycle over the nonzero weights until they converge
+					activeSet.clear();
+					for(std::size_t j: strongSet){
+						if(m_weights(j) != 0.0)
+							activeSet.push_back(j);
 					}
-					else if (grad < -lambda)
-					{
-						vio = -grad - lambda;
-						delta = vio / d;
-						gain = 0.5 * d * delta * delta;
-					}
-				}
-				else if (a > 0.0)
-				{
-					grad += lambda;
-					vio = std::fabs(grad);
-					delta = -grad / d;
-					if (delta < -a)
-					{
-						delta = -a;
-						gain = delta * (grad - 0.5 * d * delta);
-						double g0 = grad - a * d - 2.0 * lambda;
-						if (g0 > 0.0)
-						{
-							double dd = -g0 / d;
-							gain = dd * (grad - 0.5 * d * dd);
-							delta += dd;
-						}
-					}
-					else gain = 0.5 * d * delta * delta;
-				}
-				else
-				{
-					grad -= lambda;
-					vio = std::fabs(grad);
-					delta = -grad / d;
-					if (delta > -a)
-					{
-						delta = -a;
-						gain = delta * (grad - 0.5 * d * delta);
-						double g0 = grad - a * d + 2.0 * lambda;
-						if (g0 < 0.0)
-						{
-							double dd = -g0 / d;
-							gain = dd * (grad - 0.5 * d * dd);
-							delta += dd;
-						}
-					}
-					else gain = 0.5 * d * delta * delta;
+					while(sweep(activeSet, lambda) > m_accuracy);
 				}
 
-				// update state
-				if (vio > maxvio) maxvio = vio;
-				if (delta != 0.0)
-				{
-					w[i] += delta;
-					noalias(difference) += delta*row(data,i);
+				// KKT check of all remaining features
+				if(!m_covarianceMode){
+					SHARK_PARALLEL_FOR(int j = 0; j < (int)dim; ++j){
+						m_gradient(j) = inner_prod(m_residual, row(m_data,j));
+					}
 				}
-
-				// update gain-based preferences
-				{
-					if (iter == 0) 
-						average_gain += gain / (double)dim;
-					else
-					{
-						double change = CHANGE_RATE * (gain / average_gain - 1.0);
-						double newpref = pref[i] * std::exp(change);
-						newpref = std::min(std::max(newpref, PREF_MIN), PREF_MAX);
-						prefsum += newpref - pref[i];
-						pref[i] = newpref;
-						average_gain = (1.0 - gain_learning_rate) * average_gain + gain_learning_rate * gain;
+				bool violated = false;
+				for(std::size_t j = 0; j != dim; ++j){
+					if(!isStrong[j] && m_diag(j) > 0 && std::abs(m_gradient(j)) > lambda + m_accuracy){
+						strongSet.push_back(j);
+						isStrong[j] = 1;
+						violated = true;
 					}
 				}
+				if(!violated) break;
+			}
+		}
+	private:
+		typedef typename Batch<InputVectorType>::type BatchType;
+		static const std::size_t MaxCovarianceDimensions = 4096;
+
+		/// updates all coordinates in the set once and returns the largest violation of the optimality conditions
+		double sweep(std::vector<std::size_t> const& set, double lambda){
+			double maxViolation = 0.0;
+			for(std::size_t j: set){
+				maxViolation = std::max(maxViolation, update(j, lambda));
 			}
-			iter++;
+			return maxViolation;
+		}
 
-			if (maxvio <= m_accuracy)
-			{
-				if (canstop)
-					break;
+		/// optimal coordinate descent step for feature j, returns the violation of the optimality condition before the step
+		double update(std::size_t j, double lambda){
+			double d = m_diag(j);
+			if(d == 0.0) return 0.0;
+			double grad = m_covarianceMode? m_gradient(j) : inner_prod(m_residual, row(m_data,j));
+			double a = m_weights(j);
+			double violation;
+			if(a == 0.0)
+				violation = std::max(std::abs(grad) - lambda, 0.0);
+			else if(a > 0.0)
+				violation = std::abs(grad + lambda);
+			else
+				violation = std::abs(grad - lambda);
+
+			// soft thresholding of the unregularized solution
+			double z = a * d - grad;
+			double newWeight = 0.0;
+			if(z > lambda)
+				newWeight = (z - lambda) / d;
+			else if(z < -lambda)
+				newWeight = (z + lambda) / d;
+			double delta = newWeight - a;
+			if(delta != 0.0){
+				m_weights(j) = newWeight;
+				if(m_covarianceMode)
+					noalias(m_gradient) += delta * covarianceColumn(j);
 				else
-				{
-					// prepare full sweep for a reliable check of the stopping criterion
-					canstop = true;
-					noalias(pref) = blas::repeat(1.0, dim);
-					prefsum = (double)dim;
-					if (verbose) std::cout << "*" << std::flush;
-				}
+					noalias(m_residual) += delta * row(m_data,j);
 			}
-			else
-			{
-				canstop = false;
-				if (verbose) std::cout << "." << std::flush;
+			return violation;
+		}
+
+		/// column X^T x_j of the covariance matrix, computed when first needed
+		RealVector const& covarianceColumn(std::size_t j){
+			RealVector& column = m_covarianceColumns[j];
+			if(column.size() == 0){
+				RealVector feature = row(m_data,j);
+				column.resize(m_data.size1());
+				noalias(column) = prod(m_data, feature);
 			}
+			return column;
 		}
 
-		// write the weight vector into the model
-		RealMatrix mat(1, w.size());
-		row(mat, 0) = w;
-		model.setStructure(mat);
-	}
+		BatchType m_data;                ///< transposed data, features as rows
+		double m_accuracy;               ///< maximal violation of the optimality conditions
+		bool m_covarianceMode;           ///< whether the gradient is maintained using the covariance matrix
+		double m_lambdaMax;              ///< smallest lambda with zero solution
+		RealVector m_weights;            ///< current solution
+		RealVector m_diag;               ///< squared norms of the features
+		RealVector m_gradient;           ///< gradient of the quadratic part
+		RealVector m_residual;           ///< Xw-y, only used in naive mode
+		std::vector<RealVector> m_covarianceColumns; ///< cached columns of the covariance matrix
+	};
 
-protected:
 	double m_lambda;             ///< regularization parameter
 	double m_accuracy;           ///< gradient accuracy
 };
@@ -70,30 +70,41 @@ namespace shark{
  *  of dimensions by skipping the components with the least
  *  corresponding eigenvalues/variances. Furthermore, the eigenvalues
  *  may be rescaled to one, resulting in a whitening of the data.
+ *
+ *  Besides the exact decomposition of the covariance (STANDARD) or of the
+ *  Gram matrix (SMALL_SAMPLE), two approximate algorithms are available for
+ *  large datasets which only compute the leading components:
+ *  RANDOMIZED uses the randomized range finder of Halko, Martinsson and Tropp
+ *  with a few power iterations. Every iteration is a single parallel pass over
+ *  the batches of the data and the memory requirement is linear in the
+ *  input dimension and the number of components.
+ *  updateData() implements incremental PCA (Ross et al., 2008): the
+ *  decomposition is updated with new data without visiting the old data again,
+ *  which allows to handle data streams which do not fit into memory.
+ *  The number of components computed by both is set using setNumberOfComponents().
  */
 class PCA : public AbstractUnsupervisedTrainer<LinearModel<> >
 {
 private:
 	typedef AbstractUnsupervisedTrainer<LinearModel<> > base_type;
 public:
-	enum PCAAlgorithm { STANDARD, SMALL_SAMPLE, AUTO };
+	enum PCAAlgorithm { STANDARD, SMALL_SAMPLE, AUTO, RANDOMIZED };
 
 	/// Constructor.
 	/// The parameter defines whether the model should also
 	/// whiten the data.
 	PCA(bool whitening = false) 
-	: m_whitening(whitening){
-		m_algorithm = AUTO;
-	};
+	: m_whitening(whitening), m_n(0), m_l(0), m_algorithm(AUTO)
+	, m_components(0), m_oversampling(10), m_powerIterations(2){}
 	/// Constructor.
 	/// The parameter defines whether the model should also
 	/// whiten the data.
 	/// The eigendecomposition of the data is stored inthe PCA object.
 	PCA(UnlabeledData<RealVector> const& inputs, bool whitening = false) 
-	: m_whitening(whitening){
-		m_algorithm = AUTO;
+	: m_whitening(whitening), m_n(0), m_l(0), m_algorithm(AUTO)
+	, m_components(0), m_oversampling(10), m_powerIterations(2){
 		setData(inputs);
-	};
+	}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -105,6 +116,30 @@ public:
 		m_whitening = whitening;
 	}
 
+	/// Sets the algorithm used by setData, the default AUTO chooses
+	/// between STANDARD and SMALL_SAMPLE.
+	void setAlgorithm(PCAAlgorithm algorithm){
+		m_algorithm = algorithm;
+	}
+
+	/// Number of components computed by the RANDOMIZED algorithm and kept by updateData.
+	/// The default 0 keeps all components for updateData and uses the output size
+	/// of the model in train.
+	void setNumberOfComponents(std::size_t components){
+		m_components = components;
+	}
+
+	/// Parameters of the RANDOMIZED algorithm.
+	///
+	/// \param oversampling number of additional random directions, the
+	///     approximation of the last components improves with more oversampling.
+	/// \param powerIterations number of additional passes over the data which
+	///     sharpen the decay of the spectrum.
+	void setRandomizedParameters(std::size_t oversampling, std::size_t powerIterations){
+		m_oversampling = oversampling;
+		m_powerIterations = powerIterations;
+	}
+
 	/// Train the model to perform PCA. The model must be a
 	/// LinearModel object with offset, and its output dimension
 	/// defines the number of principal components
@@ -113,7 +148,10 @@ public:
 	/// space to the PCA coordinate system).
 	void train(LinearModel<>& model, UnlabeledData<RealVector> const& inputs) {
 		std::size_t m = model.outputSize(); ///< reduced dimensionality
-		setData(inputs);   // compute PCs
+		if(m_algorithm == RANDOMIZED && m_components == 0)
+			randomizedPCA(inputs, m); // compute only the required PCs
+		else
+			setData(inputs);   // compute PCs
 		encoder(model, m); // define the model 
 	}
 
@@ -123,6 +161,21 @@ public:
 	//! of the data is stored inthe PCA object.
 	SHARK_EXPORT_SYMBOL void setData(UnlabeledData<RealVector> const& inputs);
 
+	//! Updates the eigendecomposition with additional data without revisiting
+	//! the data seen before. The first call, or a call after reset(), starts
+	//! a new decomposition, calls after setData update its result.
+	//! The number of components kept is given by setNumberOfComponents.
+	SHARK_EXPORT_SYMBOL void updateData(UnlabeledData<RealVector> const& inputs);
+
+	//! Forgets all data, the next call to updateData starts a new decomposition.
+	void reset(){
+		m_l = 0;
+		m_n = 0;
+		m_mean.resize(0);
+		m_eigenvalues.resize(0);
+		m_eigenvectors.resize(0,0);
+	}
+
 	//! Returns a model mapping the original data to the
 	//! m-dimensional PCA coordinate system.
 	SHARK_EXPORT_SYMBOL void encoder(LinearModel<>& model, std::size_t m = 0);
@@ -135,7 +188,8 @@ public:
 	/// Eigenvalues of last training. The number of eigenvalues
 	//! is equal to the minimum of the input dimensions (i.e.,
 	//! number of attributes) and the number of data points used
-	//! for training the PCA.
+	//! for training the PCA, or the number of components
+	//! for the RANDOMIZED algorithm and updateData.
 	RealVector const& eigenvalues() const {
 		return m_eigenvalues;
 	}
@@ -170,6 +224,12 @@ protected:
 	std::size_t m_l;           ///< number of training data points
 
 	PCAAlgorithm m_algorithm;  ///< whether to use design matrix or its transpose for building covariance matrix
+	std::size_t m_components;  ///< number of components of the RANDOMIZED algorithm and updateData
+	std::size_t m_oversampling; ///< additional random directions of the RANDOMIZED algorithm
+	std::size_t m_powerIterations; ///< number of power iterations of the RANDOMIZED algorithm
+private:
+	SHARK_EXPORT_SYMBOL void randomizedPCA(UnlabeledData<RealVector> const& inputs, std::size_t components);
+	SHARK_EXPORT_SYMBOL void updateBatch(RealMatrix const& batch);
 };
 
 
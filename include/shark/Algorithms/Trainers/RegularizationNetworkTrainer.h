@@ -41,6 +41,8 @@
 #include <shark/Algorithms/Trainers/AbstractSvmTrainer.h>
 #include <shark/Models/Kernels/KernelHelpers.h>
 #include <shark/LinAlg/solveSystem.h>
+#include <shark/LinAlg/solveTriangular.h>
+#include <shark/LinAlg/KernelMatrixOperator.h>
 
 
 namespace shark {
@@ -82,6 +84,10 @@ namespace shark {
 /// of the noise. The variance of the noise is denoted by \f$
 /// \sigma_n^2 \f$ in the textbook by Rasmussen and
 /// Williams. Accordingly, \f$ C = 1/\sigma_n^2 \f$.
+///
+/// For large datasets the kernel matrix can be replaced by a low-rank
+/// approximation, see setLowRankApproximation, or the system can be solved
+/// iteratively without storing the kernel matrix, see setIterativeSolver.
 
 template <class InputType>
 class RegularizationNetworkTrainer : public AbstractSvmTrainer<InputType, RealVector,KernelExpansion<InputType> >
@@ -96,6 +102,8 @@ public:
 	/// \param unconstrained Indicates exponential encoding of the regularization parameter 
 	RegularizationNetworkTrainer(KernelType* kernel, double betaInv, bool unconstrained = false)
 	: base_type(kernel, 1.0 / betaInv, false, unconstrained)
+	, m_rank(0), m_tolerance(1.e-10)
+	, m_iterative(false), m_preconditionerRank(0), m_epsilon(1.e-8), m_maxIterations(0)
 	{ }
 
 	/// \brief From INameable: return the class name.
@@ -116,8 +124,51 @@ public:
 	void setPrecision(double beta)
 	{ this->C() = beta; }
 
+	/// \brief Returns the maximum rank of the kernel matrix approximation, 0 if the exact kernel matrix is used.
+	std::size_t lowRankApproximation() const
+	{ return m_rank; }
+
+	/// \brief Trains on a low-rank approximation of the kernel matrix.
+	///
+	/// For rank > 0 the kernel matrix K is replaced by the pivoted incomplete Cholesky
+	/// approximation \f$ K \approx LL^T \f$ with at most rank columns, see calculateIncompleteCholeskyFactor.
+	/// Training then needs O(n rank^2) time and O(n rank) memory, and the trained model is a kernel
+	/// expansion over the chosen pivots only. A rank of 0 uses the exact kernel matrix.
+	/// \param rank maximum rank of the approximation
+	/// \param tolerance the approximation stops early when the residual kernel diagonal is below this value
+	void setLowRankApproximation(std::size_t rank, double tolerance = 1.e-10){
+		m_rank = rank;
+		m_tolerance = tolerance;
+		m_iterative = false;
+	}
+
+	/// \brief Solves the linear system with preconditioned conjugate gradients instead of a Cholesky decomposition.
+	///
+	/// The kernel matrix is never stored, instead its products are computed on the fly from the
+	/// batches of the data set (see KernelMatrixOperator), which needs O(n) memory and O(n^2) kernel
+	/// evaluations per iteration. All label dimensions are solved together by block conjugate gradients.
+	/// If preconditionerRank is larger than 0, a PivotedCholeskyPreconditioner of this rank is used.
+	/// \param preconditionerRank rank of the pivoted Cholesky preconditioner, 0 for none
+	/// \param epsilon the solver stops when the max-norm of all residuals is smaller
+	/// \param maxIterations maximum number of iterations, 0 for no limit
+	void setIterativeSolver(std::size_t preconditionerRank = 100, double epsilon = 1.e-8, std::size_t maxIterations = 0){
+		m_iterative = true;
+		m_preconditionerRank = preconditionerRank;
+		m_epsilon = epsilon;
+		m_maxIterations = maxIterations;
+		m_rank = 0;
+	}
+
 	void train(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset)
 	{
+		if(m_rank != 0){
+			trainLowRank(svm,dataset);
+			return;
+		}
+		if(m_iterative){
+			trainIterative(svm,dataset);
+			return;
+		}
 		svm.setStructure(base_type::m_kernel,dataset.inputs(),false);
 		
 		// Setup the kernel matrix
@@ -127,6 +178,59 @@ public:
 		blas::solveSymmPosDefSystemInPlace<blas::SolveAXB>(M,v);
 		column(svm.alpha(),0) = v;
 	}
+private:
+	std::size_t m_rank;
+	double m_tolerance;
+	bool m_iterative;
+	std::size_t m_preconditionerRank;
+	double m_epsilon;
+	std::size_t m_maxIterations;
+
+	void trainIterative(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset){
+		RealMatrix Y = createBatch<RealVector>(dataset.labels().elements());
+		KernelMatrixOperator<InputType> K(*(this->m_kernel),dataset.inputs(),noiseVariance());
+		RealMatrix alpha;
+		if(m_preconditionerRank != 0){
+			PivotedCholeskyPreconditioner<InputType> preconditioner(
+				*(this->m_kernel),dataset.inputs(),noiseVariance(),m_preconditionerRank
+			);
+			blas::conjugateGradient(K,preconditioner,alpha,Y,m_epsilon,false,m_maxIterations);
+		}else{
+			blas::conjugateGradient(K,blas::IdentityPreconditioner(),alpha,Y,m_epsilon,false,m_maxIterations);
+		}
+		svm.setStructure(base_type::m_kernel,dataset.inputs(),false,Y.size2());
+		noalias(svm.alpha()) = alpha;
+	}
+
+	void trainLowRank(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset){
+		RealMatrix L;
+		std::vector<std::size_t> pivots = calculateIncompleteCholeskyFactor(
+			*(this->m_kernel),dataset.inputs(),L,m_rank,m_tolerance
+		);
+		std::size_t m = pivots.size();
+		RealVector y = column(createBatch<RealVector>(dataset.labels().elements()),0);
+
+		//ridge regression on the features given by the rows of L:
+		//w = (sigma^2 I + L^TL)^{-1} L^T y
+		RealMatrix A = prod(trans(L),L);
+		for(std::size_t i = 0; i != m; ++i)
+			A(i,i) += noiseVariance();
+		RealVector w = prod(trans(L),y);
+		blas::solveSymmPosDefSystemInPlace<blas::SolveAXB>(A,w);
+
+		//the feature map of a point x is L_I^{-1} k(I,x) where L_I are the rows of the pivots,
+		//thus the coefficients of the pivots are L_I^{-T} w
+		RealMatrix pivotFactor(m,m);
+		std::vector<InputType> basis(m);
+		for(std::size_t i = 0; i != m; ++i){
+			noalias(row(pivotFactor,i)) = row(L,pivots[i]);
+			basis[i] = dataset.inputs().element(pivots[i]);
+		}
+		blas::solveTriangularSystemInPlace<blas::SolveXAB,blas::lower>(pivotFactor,w);
+
+		svm.setStructure(base_type::m_kernel,createDataFromRange(basis),false);
+		column(svm.alpha(),0) = w;
+	}
 };
 
 
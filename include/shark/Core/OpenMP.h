@@ -34,10 +34,10 @@
 #define SHARK_CORE_OPENMP_H
 
 #include <shark/Core/Shark.h>
+#include <boost/config.hpp>
 
 #ifdef SHARK_USE_OPENMP
 #include <omp.h>
-#include <boost/config.hpp>
 
 #if defined(BOOST_MSVC) || defined(__INTEL_COMPILER)
 #define SHARK_PARALLEL_FOR __pragma(omp parallel for)\
@@ -63,4 +63,21 @@ for
 #define SHARK_THREAD_NUM (std::size_t)0
 #endif
 
+//SHARK_SIMD_FOR marks a loop without dependencies between iterations for vectorization.
+//The loop condition must use <, as required by the OpenMP simd construct.
+#if defined(BOOST_MSVC)
+#define SHARK_SIMD_FOR __pragma(loop(ivdep))\
+for
+#elif defined(_OPENMP) && _OPENMP >= 201307
+#define SHARK_SIMD_FOR \
+_Pragma ( "omp simd" )\
+for
+#elif defined(__GNUC__) && !defined(__clang__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define SHARK_SIMD_FOR \
+_Pragma ( "GCC ivdep" )\
+for
+#else
+#define SHARK_SIMD_FOR for
+#endif
+
 #endif
@@ -247,7 +247,7 @@ struct Batch<shark::blas::compressed_vector<T> >{
 		//before creating the batch, we need the number of nonzero elements
 		std::size_t nonzeros = 0;
 		for(typename Range::const_iterator pos = range.begin(); pos != range.end(); ++pos){
-			nonzeros += pos->nnz();
+			nonzeros += std::distance(pos->begin(),pos->end());
 		}
 		
 		type batch(range.size(),range.begin()->size(),nonzeros);
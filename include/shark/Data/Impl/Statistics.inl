@@ -90,15 +90,73 @@ void meanvar
 	covariance().clear();
 	
 	meanVec() = mean(data);
-	//sum of variances of each column
-	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
-		//make the batch mean-free
-		BatchType batch = data.batch(b)-repeat(meanVec,data.batch(b).size1());
-		noalias(covariance) += prod(trans(batch),batch);
-	}
+	//sum of the outer products of the mean-free batches
+	scatterMatrix(data,[&](BatchType const& batch) -> BatchType{
+		return batch-repeat(meanVec,batch.size1());
+	},covariance);
 	covariance() /= double(dataSize);
 }
 
+/*!
+ *  \brief Calculates the symmetric matrix \f$ \sum_b T(B_b)^T T(B_b) \f$ over all batches of a dataset
+ *
+ *  The transformation maps a batch of the dataset to a dense matrix, for example
+ *  the mean-free inputs or inputs and labels concatenated columnwise. This allows
+ *  to compute scatter matrices, second moments and the normal equations of
+ *  least squares problems in a single pass over the data.
+ *
+ *  Every thread handles a contiguous range of batches and accumulates the
+ *  lower triangle of its own partial matrix using the symmetric rank-k update,
+ *  the partial matrices are added at the end.
+ *
+ *      \param  dataset any dataset providing batch(i) and numberOfBatches()
+ *      \param  transformation function mapping a batch of the dataset to a dense matrix
+ *      \param  scatter the resulting symmetric matrix
+ */
+template<class DatasetType, class Transformation, class MatT>
+void scatterMatrix
+(
+	DatasetType const& dataset,
+	Transformation transformation,
+	blas::matrix_container<MatT, blas::cpu_tag>& scatter
+){
+	typedef typename MatT::value_type value_type;
+	std::size_t numBatches = dataset.numberOfBatches();
+	SIZE_CHECK(numBatches > 0);
+	std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
+	std::size_t batchesPerThread = numBatches/numThreads;
+	std::size_t leftOver = numBatches - batchesPerThread*numThreads;
+	bool initialized = false;
+	SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in paralll loops
+		std::size_t t = ti;
+		std::size_t start = t*batchesPerThread+std::min(t,leftOver);
+		std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
+		blas::matrix<value_type> threadScatter;
+		for(std::size_t b = start; b != end; ++b){
+			blas::matrix<value_type> transformed = transformation(dataset.batch(b));
+			if(b == start){
+				threadScatter.resize(transformed.size2(),transformed.size2());
+				threadScatter.clear();
+			}
+			blas::kernels::syrk<false>(trans(transformed),threadScatter,value_type(1));
+		}
+		SHARK_CRITICAL_REGION{
+			if(!initialized){
+				scatter().resize(threadScatter.size1(),threadScatter.size2());
+				scatter().clear();
+				initialized = true;
+			}
+			noalias(scatter) += threadScatter;
+		}
+	}
+	//only the lower triangle was computed
+	for(std::size_t i = 0; i != scatter().size1(); ++i){
+		for(std::size_t j = 0; j != i; ++j){
+			scatter()(j,i) = scatter()(i,j);
+		}
+	}
+}
+
 /*!
  *  \brief Calculates the mean vector of array "x".
  *
@@ -35,6 +35,8 @@
 #define SHARK_DATA_STATISTICS_H
 
 #include <shark/Data/Dataset.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/LinAlg/BLAS/kernels/syrk.hpp>
 
 /**
 * \ingroup shark_globals
@@ -61,6 +63,15 @@ void meanvar
 	blas::matrix_container<MatT, Device>& variance
 );
 
+//! Calculates the symmetric matrix \f$ \sum_b T(B_b)^T T(B_b) \f$ over all batches \f$ B_b \f$ of a dataset in parallel.
+template<class DatasetType, class Transformation, class MatT>
+void scatterMatrix
+(
+	DatasetType const& dataset,
+	Transformation transformation,
+	blas::matrix_container<MatT, blas::cpu_tag>& scatter
+);
+
 //! Calculates the mean vector of the input vectors.
 template<class VectorType>
 VectorType mean(Data<VectorType> const& data);
@@ -0,0 +1,364 @@
+/*!
+ * \brief       Lowering of elementwise expressions over dense storage to raw memory accesses
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_LINALG_BLAS_DETAIL_DENSE_EVALUATOR_HPP
+#define SHARK_LINALG_BLAS_DETAIL_DENSE_EVALUATOR_HPP
+
+#include "traits.hpp"
+#include <type_traits>
+#include <cstddef>
+
+namespace shark {
+namespace blas {
+
+//forward declarations of the expressions which can be lowered
+template<class E> class vector_scalar_multiply;
+template<class T> class scalar_vector;
+template<class E, class F> class vector_unary;
+template<class E1, class E2> class vector_addition;
+template<class E1, class E2, class F> class vector_binary;
+template<class E> class matrix_scalar_multiply;
+template<class T> class scalar_matrix;
+template<class V> class vector_repeater;
+template<class E, class F> class matrix_unary;
+template<class E1, class E2> class matrix_addition;
+template<class E1, class E2, class F> class matrix_binary;
+
+namespace detail {
+
+///\brief Number of elements above which the fused dense assignment kernels distribute the work among threads.
+static const std::size_t dense_parallel_assign_threshold = 1<<16;
+
+///\brief Evaluates an elementwise vector expression directly on the memory of its dense arguments.
+///
+///The evaluator mirrors the expression tree, but the leaves access the raw storage instead of going through
+///the proxies. Thus the whole expression is computed in a single loop over plain pointers which
+///the compiler is able to vectorize. An evaluator provides the flag lowerable, which is false if the expression
+///contains a part which can not be lowered (e.g. sparse arguments). If it is lowerable,
+///it can be constructed from the expression and provides contiguous(), which returns whether all leaves have unit stride,
+///and operator()(i) returning the i-th element of the expression. operator() may only be used when contiguous() is true.
+template<class E, class StorageTag = typename E::storage_type::storage_tag>
+struct dense_vector_evaluator{
+	static const bool lowerable = false;
+};
+
+template<class E>
+struct dense_vector_evaluator<E, dense_tag>{
+	static const bool lowerable = true;
+	typedef typename E::value_type value_type;
+
+	explicit dense_vector_evaluator(E const& e)
+	: m_values(e.raw_storage().values), m_stride(e.raw_storage().stride){}
+
+	bool contiguous()const{
+		return m_stride == 1;
+	}
+	value_type operator()(std::size_t i)const{
+		return m_values[i];
+	}
+private:
+	value_type const* m_values;
+	std::size_t m_stride;
+};
+
+template<class T>
+struct dense_vector_evaluator<scalar_vector<T>, unknown_tag>{
+	static const bool lowerable = true;
+	typedef T value_type;
+
+	explicit dense_vector_evaluator(scalar_vector<T> const& e)
+	: m_value(e(0)){}
+
+	bool contiguous()const{
+		return true;
+	}
+	value_type operator()(std::size_t)const{
+		return m_value;
+	}
+private:
+	value_type m_value;
+};
+
+template<class E>
+struct dense_vector_evaluator<vector_scalar_multiply<E>, unknown_tag>{
+	typedef dense_vector_evaluator<typename E::const_closure_type> argument_evaluator;
+	static const bool lowerable = argument_evaluator::lowerable;
+	typedef typename vector_scalar_multiply<E>::value_type value_type;
+	typedef typename vector_scalar_multiply<E>::scalar_type scalar_type;
+
+	explicit dense_vector_evaluator(vector_scalar_multiply<E> const& e)
+	: m_argument(e.expression()), m_scalar(e.scalar()){}
+
+	bool contiguous()const{
+		return m_argument.contiguous();
+	}
+	value_type operator()(std::size_t i)const{
+		return m_scalar * m_argument(i);
+	}
+private:
+	argument_evaluator m_argument;
+	scalar_type m_scalar;
+};
+
+template<class E, class F>
+struct dense_vector_evaluator<vector_unary<E, F>, unknown_tag>{
+	typedef dense_vector_evaluator<typename E::const_closure_type> argument_evaluator;
+	static const bool lowerable = argument_evaluator::lowerable;
+	typedef typename vector_unary<E, F>::value_type value_type;
+
+	explicit dense_vector_evaluator(vector_unary<E, F> const& e)
+	: m_argument(e.expression()), m_functor(e.functor()){}
+
+	bool contiguous()const{
+		return m_argument.contiguous();
+	}
+	value_type operator()(std::size_t i)const{
+		return m_functor(m_argument(i));
+	}
+private:
+	argument_evaluator m_argument;
+	F m_functor;
+};
+
+template<class E1, class E2>
+struct dense_vector_evaluator<vector_addition<E1, E2>, unknown_tag>{
+	typedef dense_vector_evaluator<typename E1::const_closure_type> lhs_evaluator;
+	typedef dense_vector_evaluator<typename E2::const_closure_type> rhs_evaluator;
+	static const bool lowerable = lhs_evaluator::lowerable && rhs_evaluator::lowerable;
+	typedef typename vector_addition<E1, E2>::value_type value_type;
+
+	explicit dense_vector_evaluator(vector_addition<E1, E2> const& e)
+	: m_lhs(e.lhs()), m_rhs(e.rhs()){}
+
+	bool contiguous()const{
+		return m_lhs.contiguous() && m_rhs.contiguous();
+	}
+	value_type operator()(std::size_t i)const{
+		return m_lhs(i) + m_rhs(i);
+	}
+private:
+	lhs_evaluator m_lhs;
+	rhs_evaluator m_rhs;
+};
+
+template<class E1, class E2, class F>
+struct dense_vector_evaluator<vector_binary<E1, E2, F>, unknown_tag>{
+	typedef dense_vector_evaluator<typename E1::const_closure_type> lhs_evaluator;
+	typedef dense_vector_evaluator<typename E2::const_closure_type> rhs_evaluator;
+	static const bool lowerable = lhs_evaluator::lowerable && rhs_evaluator::lowerable;
+	typedef typename vector_binary<E1, E2, F>::value_type value_type;
+
+	explicit dense_vector_evaluator(vector_binary<E1, E2, F> const& e)
+	: m_lhs(e.lhs()), m_rhs(e.rhs()), m_functor(e.functor()){}
+
+	bool contiguous()const{
+		return m_lhs.contiguous() && m_rhs.contiguous();
+	}
+	value_type operator()(std::size_t i)const{
+		return m_functor(m_lhs(i), m_rhs(i));
+	}
+private:
+	lhs_evaluator m_lhs;
+	rhs_evaluator m_rhs;
+	F m_functor;
+};
+
+///\brief Evaluates an elementwise matrix expression directly on the memory of its dense arguments.
+///
+///Same as dense_vector_evaluator, only that operator()(i,j) returns the element (i,j) of the expression.
+///Only row-major dense arguments can be lowered, for which all rows are contiguous.
+///In this case contiguous() refers to the rows of the arguments.
+template<
+	class E,
+	class StorageTag = typename E::storage_type::storage_tag,
+	class Orientation = typename E::orientation
+>
+struct dense_matrix_evaluator{
+	static const bool lowerable = false;
+};
+
+template<class E>
+struct dense_matrix_evaluator<E, dense_tag, row_major>{
+	static const bool lowerable = true;
+	typedef typename E::value_type value_type;
+
+	explicit dense_matrix_evaluator(E const& e)
+	: m_values(e.raw_storage().values), m_leadingDimension(e.raw_storage().leading_dimension){}
+
+	bool contiguous()const{
+		return true;
+	}
+	value_type operator()(std::size_t i, std::size_t j)const{
+		return m_values[i * m_leadingDimension + j];
+	}
+private:
+	value_type const* m_values;
+	std::size_t m_leadingDimension;
+};
+
+template<class T, class Orientation>
+struct dense_matrix_evaluator<scalar_matrix<T>, unknown_tag, Orientation>{
+	static const bool lowerable = true;
+	typedef T value_type;
+
+	explicit dense_matrix_evaluator(scalar_matrix<T> const& e)
+	: m_value(e(0,0)){}
+
+	bool contiguous()const{
+		return true;
+	}
+	value_type operator()(std::size_t, std::size_t)const{
+		return m_value;
+	}
+private:
+	value_type m_value;
+};
+
+template<class V, class Orientation>
+struct dense_matrix_evaluator<vector_repeater<V>, unknown_tag, Orientation>{
+	typedef dense_vector_evaluator<typename V::const_closure_type> argument_evaluator;
+	static const bool lowerable = argument_evaluator::lowerable;
+	typedef typename vector_repeater<V>::value_type value_type;
+
+	explicit dense_matrix_evaluator(vector_repeater<V> const& e)
+	: m_argument(e.expression()){}
+
+	bool contiguous()const{
+		return m_argument.contiguous();
+	}
+	value_type operator()(std::size_t, std::size_t j)const{
+		return m_argument(j);
+	}
+private:
+	argument_evaluator m_argument;
+};
+
+template<class E, class Orientation>
+struct dense_matrix_evaluator<matrix_scalar_multiply<E>, unknown_tag, Orientation>{
+	typedef dense_matrix_evaluator<typename E::const_closure_type> argument_evaluator;
+	static const bool lowerable = argument_evaluator::lowerable;
+	typedef typename matrix_scalar_multiply<E>::value_type value_type;
+	typedef typename matrix_scalar_multiply<E>::scalar_type scalar_type;
+
+	explicit dense_matrix_evaluator(matrix_scalar_multiply<E> const& e)
+	: m_argument(e.expression()), m_scalar(e.scalar()){}
+
+	bool contiguous()const{
+		return m_argument.contiguous();
+	}
+	value_type operator()(std::size_t i, std::size_t j)const{
+		return m_scalar * m_argument(i,j);
+	}
+private:
+	argument_evaluator m_argument;
+	scalar_type m_scalar;
+};
+
+template<class E, class F, class Orientation>
+struct dense_matrix_evaluator<matrix_unary<E, F>, unknown_tag, Orientation>{
+	typedef dense_matrix_evaluator<typename E::const_closure_type> argument_evaluator;
+	static const bool lowerable = argument_evaluator::lowerable;
+	typedef typename matrix_unary<E, F>::value_type value_type;
+
+	explicit dense_matrix_evaluator(matrix_unary<E, F> const& e)
+	: m_argument(e.expression()), m_functor(e.functor()){}
+
+	bool contiguous()const{
+		return m_argument.contiguous();
+	}
+	value_type operator()(std::size_t i, std::size_t j)const{
+		return m_functor(m_argument(i,j));
+	}
+private:
+	argument_evaluator m_argument;
+	F m_functor;
+};
+
+template<class E1, class E2, class Orientation>
+struct dense_matrix_evaluator<matrix_addition<E1, E2>, unknown_tag, Orientation>{
+	typedef dense_matrix_evaluator<typename E1::const_closure_type> lhs_evaluator;
+	typedef dense_matrix_evaluator<typename E2::const_closure_type> rhs_evaluator;
+	static const bool lowerable = lhs_evaluator::lowerable && rhs_evaluator::lowerable;
+	typedef typename matrix_addition<E1, E2>::value_type value_type;
+
+	explicit dense_matrix_evaluator(matrix_addition<E1, E2> const& e)
+	: m_lhs(e.lhs()), m_rhs(e.rhs()){}
+
+	bool contiguous()const{
+		return m_lhs.contiguous() && m_rhs.contiguous();
+	}
+	value_type operator()(std::size_t i, std::size_t j)const{
+		return m_lhs(i,j) + m_rhs(i,j);
+	}
+private:
+	lhs_evaluator m_lhs;
+	rhs_evaluator m_rhs;
+};
+
+template<class E1, class E2, class F, class Orientation>
+struct dense_matrix_evaluator<matrix_binary<E1, E2, F>, unknown_tag, Orientation>{
+	typedef dense_matrix_evaluator<typename E1::const_closure_type> lhs_evaluator;
+	typedef dense_matrix_evaluator<typename E2::const_closure_type> rhs_evaluator;
+	static const bool lowerable = lhs_evaluator::lowerable && rhs_evaluator::lowerable;
+	typedef typename matrix_binary<E1, E2, F>::value_type value_type;
+
+	explicit dense_matrix_evaluator(matrix_binary<E1, E2, F> const& e)
+	: m_lhs(e.lhs()), m_rhs(e.rhs()), m_functor(e.functor()){}
+
+	bool contiguous()const{
+		return m_lhs.contiguous() && m_rhs.contiguous();
+	}
+	value_type operator()(std::size_t i, std::size_t j)const{
+		return m_functor(m_lhs(i,j), m_rhs(i,j));
+	}
+private:
+	lhs_evaluator m_lhs;
+	rhs_evaluator m_rhs;
+	F m_functor;
+};
+
+///\brief Presents a single row of a lowered matrix expression as lowered vector expression.
+template<class MatrixEvaluator>
+struct dense_matrix_row_evaluator{
+	typedef typename MatrixEvaluator::value_type value_type;
+
+	dense_matrix_row_evaluator(MatrixEvaluator const& e, std::size_t i)
+	: m_expression(e), m_i(i){}
+
+	bool contiguous()const{
+		return m_expression.contiguous();
+	}
+	value_type operator()(std::size_t j)const{
+		return m_expression(m_i,j);
+	}
+private:
+	MatrixEvaluator const& m_expression;
+	std::size_t m_i;
+};
+
+}}}
+#endif
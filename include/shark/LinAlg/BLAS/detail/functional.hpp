@@ -621,6 +621,17 @@ struct scalar_binary_max{
 
 
 ///////////////////BINARY ASSIGNMENT/////////////////////////////////
+template<class T1, class T2>
+struct scalar_assign{
+	typedef T1 argument1_type;
+	typedef T2 argument2_type;
+	static const bool right_zero_identity = false;
+	static const bool left_zero_identity = false;
+	void operator()(argument1_type t1, argument2_type t2) {
+		t1 = static_cast<typename std::decay<T1>::type const>(t2);
+	}
+};
+
 template<class T1, class T2>
 struct scalar_plus_assign{
 	typedef T1 argument1_type;
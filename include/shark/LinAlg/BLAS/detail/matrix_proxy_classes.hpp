@@ -483,8 +483,8 @@ public:
 
 	typedef matrix_vector_range<M> closure_type;
 	typedef matrix_vector_range<typename const_expression<M>::type> const_closure_type;
-	typedef typename storage<M>::type storage_type;
-	typedef typename M::const_storage_type const_storage_type;
+	typedef typename storage<M>::type::row_storage storage_type;
+	typedef typename M::const_storage_type::row_storage const_storage_type;
 	typedef typename M::evaluation_category evaluation_category;
 
 	// Construction and destruction
@@ -525,7 +525,7 @@ public:
 	
 	/// \brief Returns the underlying storage_type structure for low level access
 	storage_type raw_storage()const{
-		return m_expression.raw_storage().diag();
+		return m_expression.raw_storage().sub_region(m_start1, m_start2, typename M::orientation()).diag();
 	}
 	
 	// ---------
@@ -61,6 +61,13 @@ struct dense_vector_storage{
 	T* values;
 	std::size_t stride;
 	
+	dense_vector_storage(){}
+	dense_vector_storage(T* v, std::size_t s):values(v),stride(s){}
+	///\brief Conversion from the storage of a less cv-qualified type, e.g. from T to T const
+	template<class U>
+	dense_vector_storage(dense_vector_storage<U> const& storage)
+	:values(storage.values),stride(storage.stride){}
+	
 	dense_vector_storage<T> sub_region(std::size_t offset){
 		return {values+offset*stride, stride};
 	}
@@ -81,6 +88,13 @@ struct dense_matrix_storage{
 	T* values;
 	std::size_t leading_dimension;
 	
+	dense_matrix_storage(){}
+	dense_matrix_storage(T* v, std::size_t ld):values(v),leading_dimension(ld){}
+	///\brief Conversion from the storage of a less cv-qualified type, e.g. from T to T const
+	template<class U>
+	dense_matrix_storage(dense_matrix_storage<U> const& storage)
+	:values(storage.values),leading_dimension(storage.leading_dimension){}
+	
 	template<class Orientation>
 	dense_matrix_storage<T> sub_region(std::size_t offset1, std::size_t offset2, Orientation){
 		std::size_t offset_major = Orientation::index_M(offset1,offset2);
@@ -92,7 +106,6 @@ struct dense_matrix_storage{
 	row_storage row(std::size_t i, Orientation){
 		return {values + i * Orientation::index_M(leading_dimension,1), Orientation::index_m(leading_dimension,1)};
 	}
-	template<class Orientation>
 	row_storage diag(){
 		return {values, leading_dimension+1};
 	}
@@ -31,14 +31,20 @@
 #define SHARK_LINALG_BLAS_KERNELS_DEFAULT_POTRF_HPP
 
 #include "../../expression_types.hpp"
+#include <shark/LinAlg/BLAS/kernels/gemm.hpp>
+#include <shark/LinAlg/BLAS/kernels/trsm.hpp>
+#include <shark/Core/OpenMP.h>
 #include <boost/mpl/bool.hpp>
+#include <algorithm>
 
 namespace shark {
 namespace blas {
 namespace bindings {
 
+//The unblocked kernels return 0 on success, otherwise the index of the
+//first non-positive pivot, starting at one.
 
-//upper potrf(row-major)
+//lower potrf(row-major)
 template<class MatA>
 std::size_t potrf_impl(
     matrix_expression<MatA, cpu_tag>& A,
@@ -53,7 +59,7 @@ std::size_t potrf_impl(
 			}
 			if(i == j) {
 				if(s <= 0)
-					return i;
+					return i+1;
 				A()(i, j) = std::sqrt(s);
 			} else {
 				A()(i, j) = s / A()(j , j);
@@ -63,7 +69,7 @@ std::size_t potrf_impl(
 	return 0;
 }
 
-//lower potrf(row-major)
+//upper potrf(row-major)
 template<class MatA>
 std::size_t potrf_impl(
     matrix_expression<MatA, cpu_tag>& A,
@@ -72,8 +78,8 @@ std::size_t potrf_impl(
 	std::size_t m = A().size1();
 	for(size_t i = 0; i < m; i++) {
 		double& Aii = A()(i, i);
-		if(Aii < 0)
-			return i;
+		if(Aii <= 0)
+			return i+1;
 		using std::sqrt;
 		Aii = sqrt(Aii);
 		//update row
@@ -90,15 +96,81 @@ std::size_t potrf_impl(
 	return 0;
 }
 
+//blocked right-looking lower potrf.
+//In every step, a diagonal block is factorized by the unblocked kernel, the panel below it
+//is computed by a triangular solve and the trailing matrix is updated
+//by the matrix-matrix product A22 -= A21 A21^T. Only the lower triangle of A22 is updated,
+//in parallel over blocks of rows.
+template<class MatA>
+std::size_t potrf_block(
+    matrix_expression<MatA, cpu_tag>& A,
+    lower
+) {
+	std::size_t m = A().size1();
+	std::size_t blockSize = 64;
+	for(std::size_t k = 0; k < m; k += blockSize) {
+		std::size_t kEnd = std::min(k + blockSize, m);
+		auto Akk = subrange(A(),k,kEnd,k,kEnd);
+		std::size_t info = potrf_impl(Akk, row_major(), lower());
+		if(info != 0)
+			return k + info;
+		if(kEnd == m)
+			break;
+
+		//A21 <- A21 L11^-T, solved as L11 A21^T = A21^T
+		auto A21 = subrange(A(),kEnd,m,k,kEnd);
+		auto A21T = trans(A21);
+		kernels::trsm<false,false>(Akk, A21T);
+
+		//A22 <- A22 - A21 A21^T
+		auto A22 = subrange(A(),kEnd,m,kEnd,m);
+		std::size_t n = m - kEnd;
+		std::size_t numBlocks = (n + blockSize - 1) / blockSize;
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b) {
+			std::size_t start = b * blockSize;
+			std::size_t end = std::min(start + blockSize, n);
+			if(start > 0) {
+				auto block = subrange(A22,start,end,0,start);
+				kernels::gemm(rows(A21,start,end), trans(rows(A21,0,start)), block, -1.0);
+			}
+			//lower triangle of the diagonal block
+			for(std::size_t i = start; i != end; ++i) {
+				for(std::size_t j = start; j <= i; ++j) {
+					A22(i,j) -= inner_prod(row(A21,i),row(A21,j));
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+//blocked upper potrf, the lower factorization of the transpose
+template<class MatA>
+std::size_t potrf_block(
+    matrix_expression<MatA, cpu_tag>& A,
+    upper
+) {
+	blas::matrix_transpose<MatA> transA(A());
+	return potrf_block(transA, lower());
+}
+
+//dispatcher for row major
+template<class MatA, class Triangular>
+std::size_t potrf_dispatch(
+    matrix_container<MatA, cpu_tag>& A,
+    row_major, Triangular
+) {
+	return potrf_block(A(), Triangular());
+}
 
 //dispatcher for column major
 template<class MatA, class Triangular>
-std::size_t potrf_impl(
+std::size_t potrf_dispatch(
     matrix_container<MatA, cpu_tag>& A,
     column_major, Triangular
 ) {
 	blas::matrix_transpose<MatA> transA(A());
-	return potrf_impl(transA, row_major(), typename Triangular::transposed_orientation());
+	return potrf_block(transA, typename Triangular::transposed_orientation());
 }
 
 //dispatcher
@@ -108,7 +180,7 @@ std::size_t potrf(
     matrix_container<MatA, cpu_tag>& A,
     boost::mpl::false_//unoptimized
 ) {
-	return potrf_impl(A, typename MatA::orientation(), Triangular());
+	return potrf_dispatch(A, typename MatA::orientation(), Triangular());
 }
 
 }
@@ -2,7 +2,7 @@
 /*!
  * 
  *
- * \brief      Contains the lapack bindings for the symmetric eigenvalue problem syev.
+ * \brief      Default implementation of the symmetric eigenvalue problem syev.
  *
  * \author      O. Krause
  * \date        2010
@@ -33,9 +33,16 @@
 #define SHARK_LINALG_BLAS_KERNELS_DEFAULT_SYEV_HPP
 
 #include "../../detail/traits.hpp"
+#include <shark/LinAlg/BLAS/kernels/gemm.hpp>
+#include <shark/LinAlg/BLAS/kernels/gemv.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cmath>
 
 namespace shark { namespace blas { namespace bindings {
-	
+
+///\brief Sorts the eigenvalues in descending order and permutes the eigenvectors stored in the columns accordingly.
 template <typename MatA, typename V>
 void eigensort
 (
@@ -46,234 +53,480 @@ void eigensort
 	SIZE_CHECK(matA().size1() == matA().size2());
 
 	std::size_t n = eigenValues().size();
-
-	for (std::size_t i = 0; i < n - 1; i++)
-	{
-		std::size_t l = arg_max(subrange(eigenValues,i,n))+i;
-		if (l != i) {
-		        //switch position of i's eigenvalue and the largest remaining eigenvalue
-			std::swap(eigenValues()( l ),eigenValues()( i ));
-			//switch postions of corresponding eigenvectors
-			for (std::size_t j = 0; j < n; j++) {
-				std::swap(matA()( j , l ), matA()( j , i ));
-			}
-		}
+	std::vector<std::size_t> order(n);
+	for(std::size_t i = 0; i != n; ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(),order.end(),
+		[&](std::size_t i, std::size_t j){return eigenValues()(i) > eigenValues()(j);}
+	);
+	//apply the permutation to a copy, this moves every element only once
+	blas::vector<double> values = eigenValues();
+	blas::matrix<double> vectors = matA();
+	for(std::size_t i = 0; i != n; ++i){
+		eigenValues()(i) = values(order[i]);
+		noalias(column(matA(),i)) = column(vectors,order[i]);
 	}
 }
 
-template <typename MatA, typename V>
-void syev(
-	matrix_expression<MatA, cpu_tag>& vmatA,
-	vector_expression<V, cpu_tag>& dvecA
-) {
-	SIZE_CHECK(vmatA().size1() == vmatA().size2());
-	SIZE_CHECK(vmatA().size1() == dvecA().size());
-	
-	const std::size_t maxIterC = 50;
-	std::size_t n = vmatA().size1();
-	
-	blas::vector<double> odvecA(n,0.0);
-
-	std::size_t j, k, l, m;
-	double   b, c, f, g, h, hh, p, r, s, scale;
-
-
-	//
-	// reduction to tridiagonal form
-	//
-	for (std::size_t i = n; i-- > 1;) {
-		h = 0.0;
-		scale = 0.0;
-
-		if (i > 1) {
-			// scale row
-			for (std::size_t k = 0; k < i; k++) {
-				scale += std::fabs(vmatA()(i, k));
-			}
-		}
-
-		if (scale == 0.0) {
-			odvecA(i) = vmatA()(i, i-1);
-		}
-		else {
-			for (k = 0; k < i; k++) {
-				vmatA()(i, k) /= scale;
-				h += vmatA()(i, k) * vmatA()(i, k);
-			}
-
-			f           = vmatA()(i, i-1);
-			g           = f > 0 ? -std::sqrt(h) : std::sqrt(h);
-			odvecA(i)       = scale * g;
-			h          -= f * g;
-			vmatA()(i, i-1) = f - g;
-			f           = 0.0;
-
-			for (j = 0; j < i; j++) {
-				vmatA()(j, i) = vmatA()(i, j) / (scale * h);
-				g = 0.0;
-
-				// form element of a*u
-				for (k = 0; k <= j; k++) {
-					g += vmatA()(j, k) * vmatA()(i, k);
-				}
-
-				for (k = j + 1; k < i; k++) {
-					g += vmatA()(k, j) * vmatA()(i, k);
-				}
+///\brief Sorts eigenvalues ascending and permutes the eigenvector columns accordingly.
+inline void eigensortAscending(blas::vector<double>& d, blas::matrix<double>& Z){
+	std::size_t n = d.size();
+	std::vector<std::size_t> order(n);
+	for(std::size_t i = 0; i != n; ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(),order.end(),
+		[&](std::size_t i, std::size_t j){return d(i) < d(j);}
+	);
+	blas::vector<double> values = d;
+	blas::matrix<double> vectors = Z;
+	for(std::size_t i = 0; i != n; ++i){
+		d(i) = values(order[i]);
+		noalias(column(Z,i)) = column(vectors,order[i]);
+	}
+}
 
-				// form element of p
-				f += (odvecA(j) = g / h) * vmatA()(i, j);
+///\brief Blocked Householder reduction of a symmetric matrix to tridiagonal form.
+///
+/// A must be stored completely (both triangles). On exit, d and e contain the diagonal
+/// and sub-diagonal of T = Q^T A Q. Q is the product of the Householder reflections
+/// H_i = I - tau_i v_i v_i^T, where v_i is stored in row i of A starting at column i+1.
+/// The reflections are accumulated for blocks of columns, so that the update of the
+/// remaining matrix is a matrix-matrix product, the same way as LAPACK's sytrd.
+inline void tridiagonalize(
+	blas::matrix<double>& A,
+	blas::vector<double>& d,
+	blas::vector<double>& e,
+	blas::vector<double>& tau
+){
+	std::size_t n = A.size1();
+	std::size_t blockSize = 32;
+	d.resize(n);
+	e.resize(n - 1);
+	tau.resize(n);
+	tau.clear();
+	//the rows of WT store the vectors w of the current block
+	blas::matrix<double> WT(blockSize, n);
+	for(std::size_t k = 0; k < n; k += blockSize){
+		std::size_t kEnd = std::min(k + blockSize, n);
+		WT.clear();
+		for(std::size_t i = k; i != kEnd; ++i){
+			std::size_t j = i - k;
+			//column i of A equals row i as A is symmetric
+			auto r = subrange(row(A,i), i, n);
+			//apply the updates of the previous reflections of the block
+			if(j > 0){
+				noalias(r) -= prod(trans(subrange(A,k,i,i,n)), subrange(column(WT,i),0,j));
+				noalias(r) -= prod(trans(subrange(WT,0,j,i,n)), subrange(column(A,i),k,i));
 			}
-
-			hh = f / (h + h);
-
-			// form reduced a
-			for (j = 0; j < i; j++) {
-				f     = vmatA()(i, j);
-				g     = odvecA(j) - hh * f;
-				odvecA(j) = g;
-
-				for (k = 0; k <= j; k++) {
-					vmatA()(j, k) -= f * odvecA(k) + g * vmatA()(i, k);
-				}
+			d(i) = r(0);
+			if(i + 1 == n) break;
+
+			//generate the reflection which eliminates A(i+2:n,i)
+			auto v = subrange(r, 1, n - i);
+			double alpha = v(0);
+			double sigma = norm_sqr(subrange(v, 1, v.size()));
+			if(sigma == 0){
+				e(i) = alpha;
+				tau(i) = 0;
+				v(0) = 1;
+				continue;
 			}
-
-			for (k = i; k--;) {
-				vmatA()(i, k) *= scale;
+			double beta = std::sqrt(alpha * alpha + sigma);
+			if(alpha > 0) beta = -beta;
+			tau(i) = (beta - alpha) / beta;
+			subrange(v, 1, v.size()) /= alpha - beta;
+			v(0) = 1;
+			e(i) = beta;
+
+			//w = tau*(A v - W V^T v - V W^T v), w -= tau/2 (w^T v) v
+			auto w = subrange(row(WT,j), i + 1, n);
+			noalias(w) = prod(subrange(A,i + 1,n,i + 1,n), v);
+			if(j > 0){
+				blas::vector<double> t1 = prod(subrange(A,k,i,i + 1,n), v);
+				blas::vector<double> t2 = prod(subrange(WT,0,j,i + 1,n), v);
+				noalias(w) -= prod(trans(subrange(WT,0,j,i + 1,n)), t1);
+				noalias(w) -= prod(trans(subrange(A,k,i,i + 1,n)), t2);
 			}
+			w *= tau(i);
+			double gamma = -0.5 * tau(i) * inner_prod(w, v);
+			noalias(w) += gamma * v;
 		}
-
-		dvecA()(i) = h;
+		if(kEnd >= n) break;
+		//update of the remaining matrix A22 -= V W^T + W V^T
+		auto A22 = subrange(A, kEnd, n, kEnd, n);
+		auto VT = subrange(A, k, kEnd, kEnd, n);
+		auto WTBlock = subrange(WT, 0, kEnd - k, kEnd, n);
+		kernels::gemm(trans(VT), WTBlock, A22, -1.0);
+		kernels::gemm(trans(WTBlock), VT, A22, -1.0);
 	}
+}
 
-	dvecA()(0) = odvecA(0) = 0.0;
-
-	// accumulation of transformation matrices
-	for (std::size_t i = 0; i < n; i++) {
-		if (dvecA()(i)) {
-			for (j = 0; j < i; j++) {
-				g = 0.0;
-
-				for (k = 0; k < i; k++) {
-					g += vmatA()(i, k) * vmatA()(k, j);
-				}
-
-				for (k = 0; k < i; k++) {
-					vmatA()(k, j) -= g * vmatA()(k, i);
-				}
-			}
+///\brief Computes Z <- Q Z for the Q of tridiagonalize using blocks of reflections.
+///
+/// A block of reflections H_b...H_{b+m-1} is applied as I - V T V^T with
+/// an upper triangular m x m matrix T.
+inline void applyTridiagonalQ(
+	blas::matrix<double> const& A,
+	blas::vector<double> const& tau,
+	blas::matrix<double>& Z
+){
+	std::size_t n = A.size1();
+	if(n < 3) return;
+	std::size_t numReflections = n - 2;
+	std::size_t blockSize = 32;
+	std::size_t numBlocks = (numReflections + blockSize - 1) / blockSize;
+	for(std::size_t block = numBlocks; block-- > 0;){
+		std::size_t b = block * blockSize;
+		std::size_t bEnd = std::min(b + blockSize, numReflections);
+		std::size_t m = bEnd - b;
+		//rows of VT are the reflection vectors restricted to the rows b+1...n-1
+		blas::matrix<double> VT(m, n - b - 1, 0.0);
+		for(std::size_t j = 0; j != m; ++j){
+			noalias(subrange(row(VT,j), j, n - b - 1)) = subrange(row(A,b + j), b + j + 1, n);
 		}
-
-		dvecA()(i)     = vmatA()(i, i);
-		vmatA()(i, i) = 1.0;
-
-		for (j = 0; j < i; j++) {
-			vmatA()(i, j) = vmatA()(j, i) = 0.0;
+		blas::matrix<double> T(m, m, 0.0);
+		for(std::size_t j = 0; j != m; ++j){
+			T(j,j) = tau(b + j);
+			if(j == 0) continue;
+			blas::vector<double> t = prod(rows(VT,0,j), row(VT,j));
+			blas::vector<double> Tt = prod(subrange(T,0,j,0,j), t);
+			noalias(subrange(column(T,j),0,j)) = -tau(b + j) * Tt;
 		}
+		auto Zb = rows(Z, b + 1, n);
+		blas::matrix<double> Y(m, n, 0.0);
+		kernels::gemm(VT, Zb, Y, 1.0);
+		blas::matrix<double> TY(m, n, 0.0);
+		kernels::gemm(T, Y, TY, 1.0);
+		kernels::gemm(trans(VT), TY, Zb, -1.0);
 	}
+}
 
-	//
-	// eigenvalues from tridiagonal form
-	//
-	if (n <= 1) {
-		return;
-	}
-
-	for (std::size_t i = 1; i < n; i++) {
-		odvecA(i-1) = odvecA(i);
-	}
-
-	odvecA(n-1) = 0.0;
-
-	for (l = 0; l < n; l++) {
+///\brief Implicit QL algorithm for symmetric tridiagonal matrices.
+///
+/// d contains the diagonal, e the sub-diagonal. On exit d holds the eigenvalues
+/// and Z is multiplied from the right by the eigenvectors of the tridiagonal matrix.
+inline void tridiagonalQL(
+	blas::vector<double>& d,
+	blas::vector<double> const& subdiagonal,
+	blas::matrix<double>& Z
+){
+	const std::size_t maxIterC = 50;
+	std::size_t n = d.size();
+	if(n <= 1) return;
+	blas::vector<double> e(n, 0.0);
+	noalias(subrange(e, 0, n - 1)) = subdiagonal;
+
+	std::size_t j, m;
+	double b, c, f, g, p, r, s;
+	for (std::size_t l = 0; l < n; l++) {
 		j = 0;
-
 		do {
 			// look for small sub-diagonal element
 			for (m = l; m < n - 1; m++) {
-				s = std::fabs(dvecA()(m)) + std::fabs(dvecA()(m+1));
-				if (std::fabs(odvecA(m)) + s == s) {
+				s = std::fabs(d(m)) + std::fabs(d(m+1));
+				if (std::fabs(e(m)) + s == s) {
 					break;
 				}
 			}
-
-			p = dvecA()(l);
-
+			p = d(l);
 			if (m != l) {
 				if (j++ == maxIterC)
 					throw SHARKEXCEPTION("too many iterations in eigendecomposition");
 
 				// form shift
-				g = (dvecA()(l+1) - p) / (2.0 * odvecA(l));
+				g = (d(l+1) - p) / (2.0 * e(l));
 				r = std::sqrt(g * g + 1.0);
-				g = dvecA()(m) - p + odvecA(l) / (g + ((g) > 0 ? std::fabs(r) : -std::fabs(r)));
+				g = d(m) - p + e(l) / (g + ((g) > 0 ? std::fabs(r) : -std::fabs(r)));
 				s = c = 1.0;
 				p = 0.0;
 
 				for (std::size_t i = m; i-- > l;) {
-					f = s * odvecA(i);
-					b = c * odvecA(i);
-
+					f = s * e(i);
+					b = c * e(i);
 					if (std::fabs(f) >= std::fabs(g)) {
 						c       = g / f;
 						r       = std::sqrt(c * c + 1.0);
-						odvecA(i+1) = f * r;
+						e(i+1) = f * r;
 						s       = 1.0 / r;
 						c      *= s;
 					}
 					else {
 						s       = f / g;
 						r       = std::sqrt(s * s + 1.0);
-						odvecA(i+1) = g * r;
+						e(i+1) = g * r;
 						c       = 1.0 / r;
 						s      *= c;
 					}
-
-					g       = dvecA()(i+1) - p;
-					r       = (dvecA()(i) - g) * s + 2.0 * c * b;
+					g       = d(i+1) - p;
+					r       = (d(i) - g) * s + 2.0 * c * b;
 					p       = s * r;
-					dvecA()(i+1) = g + p;
+					d(i+1) = g + p;
 					g       = c * r - b;
 
 					// form vector
-					for (k = 0; k < n; k++) {
-						f           = vmatA()(k, i+1);
-						vmatA()(k, i+1) = s * vmatA()(k, i) + c * f;
-						vmatA()(k, i  ) = c * vmatA()(k, i) - s * f;
+					for (std::size_t k = 0; k < Z.size1(); k++) {
+						f           = Z(k, i+1);
+						Z(k, i+1) = s * Z(k, i) + c * f;
+						Z(k, i  ) = c * Z(k, i) - s * f;
 					}
 				}
-
-				dvecA()(l) -= p;
-				odvecA(l)  = g;
-				odvecA(m)  = 0.0;
+				d(l) -= p;
+				e(l)  = g;
+				e(m)  = 0.0;
 			}
 		}
 		while (m != l);
 	}
+}
 
-	//
-	// sorting eigenvalues
-	//
-	eigensort(vmatA, dvecA);
+///\brief Eigen decomposition of D + rho z z^T for a diagonal D, rho > 0 and |z|=1.
+///
+/// On entry Q contains the eigenvectors belonging to D, on exit the eigenvectors of the update
+/// and d the eigenvalues in ascending order. This is the merge step of the divide-and-conquer algorithm:
+/// after deflation of small components of z and of close eigenvalues, the secular equation
+/// 1 + rho sum_i z_i^2/(d_i - lambda) = 0 is solved for every remaining eigenvalue and the
+/// eigenvectors are computed from the recomputed z of Gu and Eisenstat, which makes
+/// them numerically orthogonal.
+inline void rankOneEigenUpdate(
+	blas::vector<double>& d,
+	blas::vector<double>& z,
+	double rho,
+	blas::matrix<double>& Q
+){
+	std::size_t n = d.size();
+	std::size_t rows = Q.size1();
+	double eps = std::numeric_limits<double>::epsilon();
 
-	//
-	// normalizing eigenvectors
-	//
-	for (std::size_t j = n; j--;) {
-		s = 0.0;
-		for (std::size_t i = n; i--;) {
-			s += vmatA()(i, j) * vmatA()(i, j);
+	//sort d ascending, together with z and the columns of Q
+	{
+		std::vector<std::size_t> order(n);
+		for(std::size_t i = 0; i != n; ++i)
+			order[i] = i;
+		std::stable_sort(order.begin(),order.end(),
+			[&](std::size_t i, std::size_t j){return d(i) < d(j);}
+		);
+		blas::vector<double> dOld = d;
+		blas::vector<double> zOld = z;
+		blas::matrix<double> QOld = Q;
+		for(std::size_t i = 0; i != n; ++i){
+			d(i) = dOld(order[i]);
+			z(i) = zOld(order[i]);
+			noalias(column(Q,i)) = column(QOld,order[i]);
 		}
-		s = std::sqrt(s);
+	}
+
+	//deflation
+	double tol = 8 * eps * std::max(norm_inf(d), rho);
+	std::vector<std::size_t> kept;
+	for(std::size_t i = 0; i != n; ++i){
+		if(rho * std::abs(z(i)) <= tol){
+			z(i) = 0;
+			continue;
+		}
+		if(!kept.empty()){
+			std::size_t p = kept.back();
+			double t = std::hypot(z(p), z(i));
+			double c = z(i) / t;
+			double s = -z(p) / t;
+			if(std::abs((d(i) - d(p)) * c * s) <= tol){
+				//rotate z(p) to zero, p becomes an eigenvector with eigenvalue d(p)
+				z(i) = t;
+				z(p) = 0;
+				for(std::size_t k = 0; k != rows; ++k){
+					double qp = Q(k,p);
+					double qi = Q(k,i);
+					Q(k,p) = c * qp + s * qi;
+					Q(k,i) = c * qi - s * qp;
+				}
+				double dp = d(p) * c * c + d(i) * s * s;
+				d(i) = d(p) * s * s + d(i) * c * c;
+				d(p) = dp;
+				kept.back() = i;
+				continue;
+			}
+		}
+		kept.push_back(i);
+	}
+	std::sort(kept.begin(),kept.end(),[&](std::size_t i, std::size_t j){return d(i) < d(j);});
+	std::size_t k = kept.size();
+	if(k == 0) {
+		eigensortAscending(d, Q);
+		return;
+	}
+
+	blas::vector<double> dk(k);
+	blas::vector<double> zk(k);
+	for(std::size_t i = 0; i != k; ++i){
+		dk(i) = d(kept[i]);
+		zk(i) = z(kept[i]);
+	}
+	double zNorm2 = norm_sqr(zk);
+
+	//solve the secular equation. Every root is stored relative to its closest pole
+	//as lambda_j = dk(origin_j) + mu_j, which keeps the differences to the poles accurate.
+	std::vector<std::size_t> origin(k);
+	blas::vector<double> mu(k);
+	blas::vector<double> delta(k);
+	for(std::size_t j = 0; j != k; ++j){
+		double lower, upper;
+		if(j + 1 < k){
+			double mid = 0.5 * (dk(j + 1) - dk(j));
+			double f = 1;
+			for(std::size_t i = 0; i != k; ++i)
+				f += rho * zk(i) * zk(i) / ((dk(i) - dk(j)) - mid);
+			if(f >= 0){
+				origin[j] = j;
+				lower = 0;
+				upper = mid;
+			}else{
+				origin[j] = j + 1;
+				lower = -mid;
+				upper = 0;
+			}
+		}else{
+			origin[j] = j;
+			lower = 0;
+			upper = rho * zNorm2;
+		}
+		double o = dk(origin[j]);
+		for(std::size_t i = 0; i != k; ++i)
+			delta(i) = dk(i) - o;
+		//bisection until the interval can not be reduced further
+		for(std::size_t iter = 0; iter != 200; ++iter){
+			double m = 0.5 * (lower + upper);
+			if(m <= lower || m >= upper) break;
+			double f = 1;
+			for(std::size_t i = 0; i != k; ++i)
+				f += rho * zk(i) * zk(i) / (delta(i) - m);
+			if(f > 0)
+				upper = m;
+			else
+				lower = m;
+		}
+		mu(j) = 0.5 * (lower + upper);
+	}
 
-		for (std::size_t i = n; i--;) {
-			vmatA()(i, j) /= s;
+	//recompute z such that the computed roots are the exact eigenvalues of a close problem
+	for(std::size_t i = 0; i != k; ++i){
+		double prod = ((dk(origin[i]) - dk(i)) + mu(i)) / rho;
+		for(std::size_t j = 0; j != k; ++j){
+			if(j == i) continue;
+			prod *= ((dk(origin[j]) - dk(i)) + mu(j)) / (dk(j) - dk(i));
 		}
+		double zi = std::sqrt(std::max(prod, 0.0));
+		zk(i) = zk(i) < 0 ? -zi : zi;
 	}
+
+	//eigenvectors of the update and the new eigenvectors as a matrix-matrix product
+	blas::matrix<double> U(k, k);
+	for(std::size_t j = 0; j != k; ++j){
+		for(std::size_t i = 0; i != k; ++i){
+			U(i,j) = zk(i) / ((dk(i) - dk(origin[j])) - mu(j));
+		}
+		column(U,j) /= norm_2(column(U,j));
+	}
+	blas::matrix<double> Qk(rows, k);
+	for(std::size_t i = 0; i != k; ++i){
+		noalias(column(Qk,i)) = column(Q,kept[i]);
+	}
+	blas::matrix<double> QU(rows, k, 0.0);
+	kernels::gemm(Qk, U, QU, 1.0);
+	for(std::size_t j = 0; j != k; ++j){
+		noalias(column(Q,kept[j])) = column(QU,j);
+		d(kept[j]) = dk(origin[j]) + mu(j);
+	}
+	eigensortAscending(d, Q);
 }
 
-/** @}*/
+///\brief Divide-and-conquer algorithm for the eigenvalues and eigenvectors of a symmetric tridiagonal matrix.
+///
+/// d contains the diagonal and e the sub-diagonal of the matrix. On exit d contains the eigenvalues
+/// in ascending order and Z the eigenvectors as columns. The matrix is split in two halves
+/// by a rank-one modification, both are solved recursively and merged by rankOneEigenUpdate.
+/// Small problems are solved by the QL algorithm.
+inline void tridiagonalEigen(
+	blas::vector<double>& d,
+	blas::vector<double> const& e,
+	blas::matrix<double>& Z
+){
+	std::size_t n = d.size();
+	Z.resize(n, n);
+	Z.clear();
+	if(n <= 32){
+		for(std::size_t i = 0; i != n; ++i)
+			Z(i,i) = 1.0;
+		tridiagonalQL(d, e, Z);
+		eigensortAscending(d, Z);
+		return;
+	}
+	//T = diag(T1,T2) + rho z z^T with z = (e_{m-1}, sign(beta) e_0)
+	std::size_t m = n / 2;
+	double beta = e(m - 1);
+	double rho = std::abs(beta);
+	blas::vector<double> d1 = subrange(d, 0, m);
+	blas::vector<double> d2 = subrange(d, m, n);
+	d1(m - 1) -= rho;
+	d2(0) -= rho;
+	blas::vector<double> e1 = subrange(e, 0, m - 1);
+	blas::vector<double> e2 = subrange(e, m, n - 1);
+	blas::matrix<double> Z1, Z2;
+	tridiagonalEigen(d1, e1, Z1);
+	tridiagonalEigen(d2, e2, Z2);
+
+	noalias(subrange(d, 0, m)) = d1;
+	noalias(subrange(d, m, n)) = d2;
+	noalias(subrange(Z, 0, m, 0, m)) = Z1;
+	noalias(subrange(Z, m, n, m, n)) = Z2;
+	if(rho == 0){
+		eigensortAscending(d, Z);
+		return;
+	}
+	//z in the eigenbasis of the two halves, normalized to unit length
+	blas::vector<double> z(n);
+	noalias(subrange(z, 0, m)) = row(Z1, m - 1);
+	noalias(subrange(z, m, n)) = row(Z2, 0);
+	if(beta < 0)
+		subrange(z, m, n) *= -1.0;
+	double zNorm = norm_2(z);
+	z /= zNorm;
+	rankOneEigenUpdate(d, z, rho * zNorm * zNorm, Z);
+}
 
-}}}
+///\brief Eigenvalues and eigenvectors of a symmetric matrix.
+///
+/// Only the lower triangle of vmatA is read. The matrix is reduced to tridiagonal form
+/// by blocked Householder reflections, the tridiagonal problem is solved by divide-and-conquer
+/// and the eigenvectors are transformed back using blocks of reflections.
+/// On exit, the columns of vmatA contain the eigenvectors and dvecA the eigenvalues in descending order.
+template <typename MatA, typename V>
+void syev(
+	matrix_expression<MatA, cpu_tag>& vmatA,
+	vector_expression<V, cpu_tag>& dvecA
+) {
+	SIZE_CHECK(vmatA().size1() == vmatA().size2());
+	SIZE_CHECK(vmatA().size1() == dvecA().size());
+	std::size_t n = vmatA().size1();
+	if(n == 0) return;
 
+	//full symmetric copy of the lower triangle
+	blas::matrix<double> A(n, n);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j <= i; ++j){
+			A(i,j) = A(j,i) = vmatA()(i,j);
+		}
+	}
+	blas::vector<double> d, e, tau;
+	tridiagonalize(A, d, e, tau);
+	blas::matrix<double> Z;
+	tridiagonalEigen(d, e, Z);
+	applyTridiagonalQ(A, tau, Z);
+
+	//descending order
+	for(std::size_t i = 0; i != n; ++i){
+		dvecA()(i) = d(n - 1 - i);
+		noalias(column(vmatA(),i)) = column(Z, n - 1 - i);
+	}
+}
+
+}}}
 #endif
@@ -0,0 +1,80 @@
+/*!
+ * 
+ *
+ * \brief       -
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_LINALG_BLAS_KERNELS_DEFAULT_SYRK_HPP
+#define SHARK_LINALG_BLAS_KERNELS_DEFAULT_SYRK_HPP
+
+#include "../../expression_types.hpp"
+#include "../../matrix.hpp"
+#include <shark/LinAlg/BLAS/kernels/gemm.hpp>
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+
+namespace shark {namespace blas {namespace bindings {
+
+//C+=alpha A A^T computed blockwise: the blocks below (or above) the diagonal are
+//general products, the diagonal blocks are computed in full and only their
+//triangle is added.
+template <bool Upper, typename MatA, typename MatC>
+void syrk(
+	matrix_expression<MatA, cpu_tag> const& A,
+	matrix_expression<MatC, cpu_tag>& C,
+	typename MatC::value_type alpha,
+	boost::mpl::false_
+){
+	typedef typename MatC::value_type value_type;
+	std::size_t n = C().size1();
+	std::size_t const blockSize = 64;
+	matrix<value_type> diagonalBlock;
+	for(std::size_t start = 0; start < n; start += blockSize){
+		std::size_t end = std::min(n, start + blockSize);
+		auto Ablock = rows(A,start,end);
+		diagonalBlock.resize(end-start,end-start);
+		diagonalBlock.clear();
+		kernels::gemm(Ablock,trans(Ablock),diagonalBlock,alpha);
+		for(std::size_t i = 0; i != end-start; ++i){
+			std::size_t first = Upper? i : 0;
+			std::size_t last = Upper? end-start : i+1;
+			for(std::size_t j = first; j != last; ++j){
+				C()(start+i,start+j) += diagonalBlock(i,j);
+			}
+		}
+		if(end == n) break;
+		if(Upper){
+			auto Cblock = subrange(C,start,end,end,n);
+			kernels::gemm(Ablock,trans(rows(A,end,n)),Cblock,alpha);
+		}else{
+			auto Cblock = subrange(C,end,n,start,end);
+			kernels::gemm(rows(A,end,n),trans(Ablock),Cblock,alpha);
+		}
+	}
+}
+
+}}}
+#endif
@@ -32,7 +32,10 @@
 #define SHARK_LINALG_BLAS_KERNELS_ATLAS_TRSM_HPP
 
 #include "../../expression_types.hpp"
+#include <shark/LinAlg/BLAS/kernels/gemm.hpp>
+#include <shark/Core/OpenMP.h>
 #include <boost/mpl/bool.hpp>
+#include <algorithm>
 
 namespace shark {namespace blas {namespace bindings {
 	
@@ -141,17 +144,65 @@ void trsm_impl(
 	}
 }
 
+//blocked solver for lower triangular matrices. The diagonal blocks are solved
+//by the unblocked kernels, everything else is a matrix-matrix product.
+template<bool Unit, class MatA, class MatB>
+void trsm_block(
+	matrix_expression<MatA, cpu_tag> const& A, matrix_expression<MatB, cpu_tag>& B,
+	std::size_t blockSize, boost::mpl::false_
+) {
+	std::size_t size = A().size1();
+	for (std::size_t start = 0; start < size; start += blockSize) {
+		std::size_t end = std::min(start + blockSize, size);
+		auto Bk = rows(B(),start,end);
+		if(start > 0){
+			kernels::gemm(subrange(A(),start,end,0,start),rows(B(),0,start),Bk,-1.0);
+		}
+		trsm_impl<Unit>(subrange(A(),start,end,start,end),Bk,boost::mpl::false_(),typename MatA::orientation());
+	}
+}
+
+//blocked solver for upper triangular matrices
+template<bool Unit, class MatA, class MatB>
+void trsm_block(
+	matrix_expression<MatA, cpu_tag> const& A, matrix_expression<MatB, cpu_tag>& B,
+	std::size_t blockSize, boost::mpl::true_
+) {
+	std::size_t size = A().size1();
+	for (std::size_t end = size; end > 0;) {
+		std::size_t start = end > blockSize? end - blockSize : 0;
+		auto Bk = rows(B(),start,end);
+		if(end < size){
+			kernels::gemm(subrange(A(),start,end,end,size),rows(B(),end,size),Bk,-1.0);
+		}
+		trsm_impl<Unit>(subrange(A(),start,end,start,end),Bk,boost::mpl::true_(),typename MatA::orientation());
+		end = start;
+	}
+}
+
 template <bool Upper, bool Unit,typename MatA, typename MatB>
 void trsm(
 	matrix_expression<MatA, cpu_tag> const& A,
 	matrix_expression<MatB, cpu_tag>& B,
 	boost::mpl::false_
 ){
-	trsm_impl<Unit>(
-		A,B,
-		boost::mpl::bool_<Upper>(),
-		typename MatA::orientation()
-	);
+	std::size_t blockSize = 64;
+	if(A().size1() <= blockSize){
+		trsm_impl<Unit>(
+			A,B,
+			boost::mpl::bool_<Upper>(),
+			typename MatA::orientation()
+		);
+		return;
+	}
+	//the columns of B are independent systems, so they are solved in parallel
+	std::size_t numColumns = B().size2();
+	std::size_t numBlocks = std::min<std::size_t>(SHARK_NUM_THREADS, (numColumns + blockSize - 1) / blockSize);
+	numBlocks = std::max<std::size_t>(numBlocks, 1);
+	SHARK_PARALLEL_FOR(int j = 0; j < (int)numBlocks; ++j){
+		auto Bj = columns(B(), j * numColumns / numBlocks, (j + 1) * numColumns / numBlocks);
+		trsm_block<Unit>(A, Bj, blockSize, boost::mpl::bool_<Upper>());
+	}
 }
 
 }}}
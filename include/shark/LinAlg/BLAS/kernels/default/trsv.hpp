@@ -31,7 +31,9 @@
 #define SHARK_LINALG_BLAS_KERNELS_DEFAULT_TRSV_HPP
 
 #include "../../expression_types.hpp"
+#include <shark/LinAlg/BLAS/kernels/gemv.hpp>
 #include <boost/mpl/bool.hpp>
+#include <algorithm>
 
 namespace shark {namespace blas {namespace bindings {
 
@@ -136,6 +138,44 @@ void trsv_impl(
 	}
 }
 
+//blocked solver for lower triangular matrices. The diagonal blocks are solved
+//by the unblocked kernels, everything else is a matrix-vector product.
+template<bool Unit, class MatA, class V>
+void trsv_block(
+	matrix_expression<MatA, cpu_tag> const& A,
+	vector_expression<V, cpu_tag> &b,
+	std::size_t blockSize, boost::mpl::false_
+) {
+	std::size_t size = A().size1();
+	for (std::size_t start = 0; start < size; start += blockSize) {
+		std::size_t end = std::min(start + blockSize, size);
+		auto bk = subrange(b(),start,end);
+		if(start > 0){
+			kernels::gemv(subrange(A(),start,end,0,start),subrange(b(),0,start),bk,-1.0);
+		}
+		trsv_impl<Unit>(subrange(A(),start,end,start,end),bk,boost::mpl::false_(),typename MatA::orientation());
+	}
+}
+
+//blocked solver for upper triangular matrices
+template<bool Unit, class MatA, class V>
+void trsv_block(
+	matrix_expression<MatA, cpu_tag> const& A,
+	vector_expression<V, cpu_tag> &b,
+	std::size_t blockSize, boost::mpl::true_
+) {
+	std::size_t size = A().size1();
+	for (std::size_t end = size; end > 0;) {
+		std::size_t start = end > blockSize? end - blockSize : 0;
+		auto bk = subrange(b(),start,end);
+		if(end < size){
+			kernels::gemv(subrange(A(),start,end,end,size),subrange(b(),end,size),bk,-1.0);
+		}
+		trsv_impl<Unit>(subrange(A(),start,end,start,end),bk,boost::mpl::true_(),typename MatA::orientation());
+		end = start;
+	}
+}
+
 //dispatcher
 
 template <bool Upper,bool Unit,typename MatA, typename V>
@@ -144,7 +184,12 @@ void trsv(
 	vector_expression<V, cpu_tag> & b,
 	boost::mpl::false_//unoptimized
 ){
-	trsv_impl<Unit>(A, b, boost::mpl::bool_<Upper>(), typename MatA::orientation());
+	std::size_t blockSize = 128;
+	if(A().size1() <= blockSize){
+		trsv_impl<Unit>(A, b, boost::mpl::bool_<Upper>(), typename MatA::orientation());
+	}else{
+		trsv_block<Unit>(A, b, blockSize, boost::mpl::bool_<Upper>());
+	}
 }
 
 }}}
@@ -84,6 +84,69 @@ void assign(
 	assign<F> (m, t, orientation());
 }
 
+/////////////////////////////////////////////////////////////////
+//////Fused evaluation of elementwise expressions on row-major memory
+////////////////////////////////////////////////////////////////
+
+//the expression can not be lowered, use the generic kernel
+template<class M, class E, class F>
+bool assign_fused(
+	matrix_expression<M, cpu_tag>&, matrix_expression<E, cpu_tag> const&,
+	F, boost::mpl::false_
+){
+	return false;
+}
+
+//the expression can be lowered, this is only possible when all rows of the arguments are contiguous in memory.
+//large matrices are split by rows among the threads, unless we are already inside a parallel region.
+template<class M, class E, class F>
+bool assign_fused(
+	matrix_expression<M, cpu_tag>& m, matrix_expression<E, cpu_tag> const& e,
+	F f, boost::mpl::true_
+){
+	typedef detail::dense_matrix_evaluator<E> evaluator_type;
+	typedef detail::dense_matrix_row_evaluator<evaluator_type> row_evaluator_type;
+	typename M::storage_type storage = m().raw_storage();
+	evaluator_type evaluator(e());
+	if(!evaluator.contiguous())
+		return false;
+	std::size_t size1 = m().size1();
+	std::size_t size2 = m().size2();
+	if(size1 == 1){
+		assign_contiguous(storage.values, row_evaluator_type(evaluator,0), f, size2);
+		return true;
+	}
+#ifdef SHARK_USE_OPENMP
+	if(size1 * size2 >= detail::dense_parallel_assign_threshold && !omp_in_parallel() && omp_get_max_threads() > 1){
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)size1; ++i){
+			assign_contiguous_range(
+				storage.values + i * storage.leading_dimension,
+				row_evaluator_type(evaluator,i), f, 0, size2
+			);
+		}
+		return true;
+	}
+#endif
+	for(std::size_t i = 0; i != size1; ++i){
+		assign_contiguous_range(
+			storage.values + i * storage.leading_dimension,
+			row_evaluator_type(evaluator,i), f, 0, size2
+		);
+	}
+	return true;
+}
+
+//tries to compute f(m(i,j),e(i,j)) for all i,j using the fused kernel, returns false if it is not applicable.
+//m must be row-major.
+template<class M, class E, class F>
+bool assign_fused(matrix_expression<M, cpu_tag>& m, matrix_expression<E, cpu_tag> const& e, F f){
+	typedef boost::mpl::bool_<
+		std::is_same<typename M::storage_type::storage_tag, dense_tag>::value
+		&& detail::dense_matrix_evaluator<E>::lowerable
+	> lowerable;
+	return assign_fused(m, e, f, lowerable());
+}
+
 /////////////////////////////////////////////////////////////////
 //////Matrix Assignment implementing op=
 ////////////////////////////////////////////////////////////////
@@ -96,6 +159,9 @@ void assign(
 	matrix_expression<E, cpu_tag> const& e,
 	row_major, row_major,TagE, TagM
 ) {
+	typedef scalar_assign<typename M::reference, typename E::value_type> functor_type;
+	if(assign_fused(m, e, functor_type()))
+		return;
 	for(std::size_t i = 0; i != m().size1(); ++i){
 		auto rowM = row(m,i);
 		kernels::assign(rowM,row(e,i));
@@ -326,6 +392,9 @@ void assign(
 	matrix_expression<E, cpu_tag> const& e,
 	row_major, row_major,TagM, TagE
 ) {
+	typedef F<typename M::reference, typename E::value_type> functor_type;
+	if(assign_fused(m, e, functor_type()))
+		return;
 	for(std::size_t i = 0; i != m().size1(); ++i){
 		auto rowM = row(m,i);
 		kernels::assign<F>(rowM,row(e,i));
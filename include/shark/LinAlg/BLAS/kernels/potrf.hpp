@@ -57,6 +57,7 @@ namespace kernels {
 ///
 /// It is better known as the cholesky decomposition for dense matrices.
 /// The algorithm works in place and does not require additional memory.
+/// Returns 0 on success, otherwise the index of the first non-positive pivot, starting at one.
 template <class Triangular, typename MatA>
 std::size_t potrf(
     matrix_container<MatA, cpu_tag>& A
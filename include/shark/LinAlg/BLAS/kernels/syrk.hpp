@@ -0,0 +1,68 @@
+/*!
+ * 
+ *
+ * \brief       Symmetric rank-k update kernel.
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_LINALG_BLAS_KERNELS_SYRK_HPP
+#define SHARK_LINALG_BLAS_KERNELS_SYRK_HPP
+
+#ifdef SHARK_USE_CBLAS
+#include "cblas/syrk.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_syrk
+// otherwise the binding will take care of this
+namespace shark { namespace blas { namespace bindings{
+template<class M1, class M2>
+struct  has_optimized_syrk
+: public boost::mpl::false_{};
+}}}
+#endif
+
+#include "default/syrk.hpp"
+
+namespace shark { namespace blas {namespace kernels{
+	
+///\brief Well known SYmmetric Rank-K update kernel M+=alpha*A*A^T.
+///
+/// Only the lower (Upper=false) or the upper (Upper=true) triangle of M is updated,
+/// which requires half the operations of the general product.
+/// The other triangle is not accessed.
+template <bool Upper, typename MatA, typename MatC>
+void syrk(
+	matrix_expression<MatA, cpu_tag> const& A,
+	matrix_expression<MatC, cpu_tag>& C,
+	typename MatC::value_type alpha
+){
+	SIZE_CHECK(C().size1() == C().size2());
+	SIZE_CHECK(C().size1() == A().size1());
+	
+	bindings::syrk<Upper>(A,C,alpha,typename bindings::has_optimized_syrk<MatA, MatC>::type());
+}
+
+}}}
+
+#endif
@@ -29,7 +29,11 @@
 #define SHARK_LINALG_BLAS_KERNELS_VECTOR_ASSIGN_HPP
 
 #include "../detail/functional.hpp"
+#include "../detail/dense_evaluator.hpp"
 #include "../expression_types.hpp"
+#include <shark/Core/OpenMP.h>
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
 
 namespace shark {
 namespace blas {
@@ -46,6 +50,73 @@ void assign(vector_expression<V, cpu_tag>& v, typename V::value_type t) {
 	}
 }
 
+/////////////////////////////////////////////////////////
+//fused evaluation of elementwise expressions on contiguous memory
+////////////////////////////////////////////////////////
+
+//computes f(v[i],e(i)) for i in [start,end). The loop only sees plain pointers,
+//so that the compiler can inline the whole expression and vectorize it.
+template<class T, class Evaluator, class F>
+void assign_contiguous_range(
+	T* v, Evaluator const& e, F f,
+	std::size_t start, std::size_t end
+){
+	SHARK_SIMD_FOR(std::size_t i = start; i < end; ++i){
+		f(v[i],e(i));
+	}
+}
+
+//large vectors are split in one chunk per thread, unless we are already inside a parallel region
+template<class T, class Evaluator, class F>
+void assign_contiguous(T* v, Evaluator const& e, F f, std::size_t size){
+#ifdef SHARK_USE_OPENMP
+	if(size >= detail::dense_parallel_assign_threshold && !omp_in_parallel() && omp_get_max_threads() > 1){
+		int numChunks = omp_get_max_threads();
+		std::size_t chunkSize = (size + numChunks - 1) / numChunks;
+		SHARK_PARALLEL_FOR(int c = 0; c < numChunks; ++c){
+			std::size_t start = std::min(size, c * chunkSize);
+			std::size_t end = std::min(size, start + chunkSize);
+			assign_contiguous_range(v, e, f, start, end);
+		}
+		return;
+	}
+#endif
+	assign_contiguous_range(v, e, f, 0, size);
+}
+
+//the expression can not be lowered, use the generic kernel
+template<class V, class E, class F>
+bool assign_fused(
+	vector_expression<V, cpu_tag>&, vector_expression<E, cpu_tag> const&,
+	F, boost::mpl::false_
+){
+	return false;
+}
+
+//the expression can be lowered, this is only possible when all arguments are contiguous in memory
+template<class V, class E, class F>
+bool assign_fused(
+	vector_expression<V, cpu_tag>& v, vector_expression<E, cpu_tag> const& e,
+	F f, boost::mpl::true_
+){
+	typename V::storage_type storage = v().raw_storage();
+	detail::dense_vector_evaluator<E> evaluator(e());
+	if(storage.stride != 1 || !evaluator.contiguous())
+		return false;
+	assign_contiguous(storage.values, evaluator, f, v().size());
+	return true;
+}
+
+//tries to compute f(v(i),e(i)) for all i using the fused kernel, returns false if it is not applicable
+template<class V, class E, class F>
+bool assign_fused(vector_expression<V, cpu_tag>& v, vector_expression<E, cpu_tag> const& e, F f){
+	typedef boost::mpl::bool_<
+		std::is_same<typename V::storage_type::storage_tag, dense_tag>::value
+		&& detail::dense_vector_evaluator<E>::lowerable
+	> lowerable;
+	return assign_fused(v, e, f, lowerable());
+}
+
 /////////////////////////////////////////////////////////
 //direct assignment of two vectors
 ////////////////////////////////////////////////////////
@@ -57,6 +128,9 @@ void assign(
 	dense_tag, dense_tag
 ) {
 	SIZE_CHECK(v().size() == e().size());
+	typedef scalar_assign<typename V::iterator::reference, typename E::value_type> functor_type;
+	if(assign_fused(v, e, functor_type()))
+		return;
 	for(std::size_t i = 0; i != v().size(); ++i){
 		v()(i) = static_cast<typename V::value_type>(e()(i));
 	}
@@ -198,6 +272,8 @@ void assign(
 	dense_tag, dense_tag
 ) {
 	SIZE_CHECK(v().size() == e().size());
+	if(assign_fused(v, e, f))
+		return;
 	for(std::size_t i = 0; i != v().size(); ++i){
 		f(v()(i),e()(i));
 	}
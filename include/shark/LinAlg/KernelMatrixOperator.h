@@ -0,0 +1,159 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Kernel matrix products computed on the fly for iterative solvers.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+
+#ifndef SHARK_LINALG_KERNELMATRIXOPERATOR_H
+#define SHARK_LINALG_KERNELMATRIXOPERATOR_H
+
+
+#include <shark/Data/Dataset.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/Cholesky.h>
+#include <shark/LinAlg/solveTriangular.h>
+#include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/Core/OpenMP.h>
+
+#include <vector>
+
+
+namespace shark {
+
+///
+/// \brief Regularized kernel Gram matrix as operator for blas::conjugateGradient.
+///
+/// Computes the product \f$ (K+\lambda I)V \f$ of the regularized kernel matrix of a dataset
+/// with a matrix V without storing the kernel matrix. The kernel matrix is evaluated
+/// block by block from the batches of the dataset, so only one block per thread needs to be stored.
+/// The block rows are distributed among the threads. Every product needs n^2 kernel evaluations,
+/// so it pays off to solve multiple right hand sides at once.
+///
+/// Like KernelMatrix this class stores a reference to the kernel and the data, they may not be
+/// altered during its lifetime.
+template <class InputType>
+class KernelMatrixOperator{
+public:
+	/// \param kernel kernel function defining the Gram matrix
+	/// \param data data to evaluate the kernel function
+	/// \param regularizer value added to the diagonal of the kernel matrix
+	KernelMatrixOperator(
+		AbstractKernelFunction<InputType> const& kernel,
+		Data<InputType> const& data,
+		double regularizer = 0
+	):mep_kernel(&kernel), m_data(data), m_regularizer(regularizer), m_batchStart(data.numberOfBatches()+1,0){
+		SHARK_CHECK(regularizer >= 0, "regularizer must be >=0");
+		for(std::size_t i = 0; i != data.numberOfBatches(); ++i){
+			m_batchStart[i+1] = m_batchStart[i]+ boost::size(data.batch(i));
+		}
+	}
+
+	/// \brief Number of rows and columns of the kernel matrix.
+	std::size_t size()const{
+		return m_batchStart.back();
+	}
+
+	/// \brief Computes KV = (K+regularizer I)V.
+	template<class MatV>
+	void operator()(MatV const& V, RealMatrix& KV)const{
+		SIZE_CHECK(V.size1() == size());
+		std::size_t B = m_data.numberOfBatches();
+		std::size_t k = V.size2();
+		KV.resize(size(),k);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)B; ++i){
+			std::size_t start = m_batchStart[i];
+			std::size_t end = m_batchStart[i+1];
+			noalias(subrange(KV,start,end,0,k)) = m_regularizer * subrange(V,start,end,0,k);
+			for(std::size_t j = 0; j != B; ++j){
+				RealMatrix block = (*mep_kernel)(m_data.batch(i), m_data.batch(j));
+				noalias(subrange(KV,start,end,0,k)) += prod(block,subrange(V,m_batchStart[j],m_batchStart[j+1],0,k));
+			}
+		}
+	}
+private:
+	AbstractKernelFunction<InputType> const* mep_kernel;
+	Data<InputType> m_data;
+	double m_regularizer;
+	std::vector<std::size_t> m_batchStart;
+};
+
+///
+/// \brief Preconditioner for regularized kernel matrices based on a pivoted incomplete Cholesky decomposition.
+///
+/// The kernel matrix K is approximated by \f$ K \approx LL^T \f$ where L has at most rank columns,
+/// see calculateIncompleteCholeskyFactor. The preconditioner applies the inverse of \f$ \lambda I + LL^T \f$,
+/// which is computed with the matrix inversion lemma in O(n rank) per vector. As the kernel spectrum
+/// decays fast for smooth kernels, a small rank already removes the large eigenvalues which slow down
+/// the conjugate gradient method.
+template <class InputType>
+class PivotedCholeskyPreconditioner{
+public:
+	/// \param kernel kernel function defining the Gram matrix
+	/// \param data data to evaluate the kernel function
+	/// \param regularizer value added to the diagonal of the kernel matrix, must be > 0
+	/// \param rank maximum rank of the approximation of the kernel matrix
+	PivotedCholeskyPreconditioner(
+		AbstractKernelFunction<InputType> const& kernel,
+		Data<InputType> const& data,
+		double regularizer,
+		std::size_t rank
+	):m_regularizer(regularizer){
+		SHARK_CHECK(regularizer > 0, "regularizer must be >0");
+		calculateIncompleteCholeskyFactor(kernel,data,m_factor,rank);
+		RealMatrix A = prod(trans(m_factor),m_factor);
+		for(std::size_t i = 0; i != A.size1(); ++i)
+			A(i,i) += regularizer;
+		blas::choleskyDecomposition(A,m_innerFactor);
+	}
+
+	/// \brief Rank of the approximation of the kernel matrix.
+	std::size_t rank()const{
+		return m_factor.size2();
+	}
+
+	/// \brief Computes \f$ Z = (\lambda I + LL^T)^{-1} R = (R-L(\lambda I + L^TL)^{-1}L^TR)/\lambda \f$.
+	template<class MatR>
+	void operator()(MatR const& R, RealMatrix& Z)const{
+		RealMatrix LR = prod(trans(m_factor),R);
+		blas::solveTriangularCholeskyInPlace<blas::SolveAXB>(m_innerFactor,LR);
+		Z = R;
+		noalias(Z) -= prod(m_factor,LR);
+		Z /= m_regularizer;
+	}
+private:
+	double m_regularizer;
+	RealMatrix m_factor;
+	RealMatrix m_innerFactor;
+};
+
+}
+#endif
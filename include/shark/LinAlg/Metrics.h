@@ -239,7 +239,7 @@ namespace detail{
 		typedef typename Result::value_type value_type;
 		std::size_t sizeX=X.size1();
 		std::size_t sizeY=Y.size1();
-		ensure_size(distances,X.size1(),Y.size1());
+		blas::ensure_size(distances,X.size1(),Y.size1());
 		if(sizeX < 10 || sizeY<10){
 			distanceSqrBlockBlockRowWise(X,Y,distances);
 			return;
@@ -252,10 +252,14 @@ namespace detail{
 		for(std::size_t i = 0; i != sizeY; ++i){
 			ySqr(i) = norm_sqr(row(Y,i));
 		}
-		//initialize d_ij=x_i^2+y_i^2
+		//add d_ij += x_i^2+y_j^2 in a single pass. Cancellation can make the result
+		//slightly negative for points close to each other, so it is clipped at zero
 		for(std::size_t i = 0; i != sizeX; ++i){
 			value_type xSqr = norm_sqr(row(X,i));
-			noalias(row(distances,i)) += repeat(xSqr,sizeY) + ySqr;
+			for(std::size_t j = 0; j != sizeY; ++j){
+				value_type d = distances(i,j) + xSqr + ySqr(j);
+				distances(i,j) = d > value_type(0)? d : value_type(0);
+			}
 		}
 	}
 	//\brief default implementation used, when one of the arguments is not dense
@@ -394,6 +398,29 @@ matrix<typename MatrixT::value_type> distanceSqr(
 	
 }
 
+/**
+* \brief Squared distance between the vectors of two sets of vectors and stores the result in the matrix of distances
+*
+* The element in the i-th row and the j-th column of distances is set to distanceSqr(x_i,y_j).
+* The result can be stored in a sub-range of a larger matrix, this way the distances to several blocks
+* of points can be computed without temporary storage. For dense arguments the distances are computed using
+* a matrix-matrix product and work for float as well as double.
+*/
+template<class MatrixT,class MatrixU, class MatrixR, class Device>
+void distanceSqr(
+	matrix_expression<MatrixT, Device> const& X,
+	matrix_expression<MatrixU, Device> const& Y,
+	matrix_expression<MatrixR, Device>& distances
+){
+	SIZE_CHECK(X().size2()==Y().size2());
+	ensure_size(distances,X().size1(),Y().size1());
+	detail::distanceSqrBlockBlock(
+		X(),Y(),distances(),
+		typename MatrixT::evaluation_category::tag(),
+		typename MatrixU::evaluation_category::tag()
+	);
+}
+
 
 /**
 * \brief Calculates distance between two vectors.
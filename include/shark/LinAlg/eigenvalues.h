@@ -35,6 +35,7 @@
 
 #include <shark/LinAlg/Base.h>
 #include <shark/LinAlg/BLAS/kernels/syev.hpp>
+#include <shark/Rng/GlobalRng.h>
 
 namespace shark{ namespace blas{
 
@@ -92,6 +93,126 @@ void eigensymm
 
 
 
+
+namespace detail{
+///\brief Orthonormalizes the rows of a matrix by modified Gram-Schmidt with reorthogonalization.
+///
+/// Rows which become linearly dependent are replaced by random directions.
+inline void orthonormalizeRows(RealMatrix& Q){
+	for(std::size_t i = 0; i != Q.size1(); ++i){
+		auto qi = row(Q,i);
+		for(std::size_t attempt = 0; attempt != 3; ++attempt){
+			double normBefore = norm_2(qi);
+			for(std::size_t pass = 0; pass != 2; ++pass){
+				for(std::size_t j = 0; j != i; ++j){
+					noalias(qi) -= inner_prod(row(Q,j),qi) * row(Q,j);
+				}
+			}
+			double normAfter = norm_2(qi);
+			if(normAfter > 1.e-10 * normBefore && normAfter > 0){
+				qi /= normAfter;
+				break;
+			}
+			for(std::size_t j = 0; j != Q.size2(); ++j){
+				qi(j) = Rng::gauss();
+			}
+		}
+	}
+}
+}
+
+/*!
+ *  \brief Computes the k largest eigenvalues and their eigenvectors of a symmetric positive semi-definite matrix.
+ *
+ *  Block subspace iteration with Rayleigh-Ritz projection: a random orthonormal basis of
+ *  k plus a few additional vectors is repeatedly multiplied by A and reorthonormalized until
+ *  the residuals \f$ \|A x_i - \lambda_i x_i\| \f$ of the first k Ritz pairs are smaller than tolerance times the
+ *  largest eigenvalue. Every iteration costs one product of A with an \f$ n \times b \f$ matrix, so this is
+ *  much faster than eigensymm when only a few eigenvectors of a large matrix are needed, for example in PCA.
+ *  The convergence speed depends on the gap between the k-th and the b-th eigenvalue.
+ *  For matrices which are not positive semi-definite, the eigenvalues of largest magnitude are found.
+ *
+ * \param A \f$ n \times n \f$ matrix, which must be symmetric, only the bottom triangular matrix is read.
+ * \param k number of eigenvalues to compute.
+ * \param eigenVectors \f$ n \times k \f$ matrix with the normalized eigenvectors as columns.
+ * \param eigenValues k-dimensional vector of eigenvalues in descending order.
+ * \param tolerance relative accuracy of the residuals.
+ * \param maxIterations maximum number of iterations.
+ * \return the number of iterations performed.
+ */
+template<class MatrixT,class MatrixU,class VectorT>
+std::size_t eigensymmPartial
+(
+	matrix_expression<MatrixT, cpu_tag> const& A,
+	std::size_t k,
+	matrix_expression<MatrixU, cpu_tag>& eigenVectors,
+	vector_expression<VectorT, cpu_tag>& eigenValues,
+	double tolerance = 1.e-10,
+	std::size_t maxIterations = 1000
+)
+{
+	SIZE_CHECK(A().size2() == A().size1());
+	SIZE_CHECK(k > 0 && k <= A().size1());
+	std::size_t n = A().size1();
+	std::size_t blockSize = std::min(n, k + std::max<std::size_t>(10, k / 2));
+	eigenVectors().resize(n,k);
+	eigenValues().resize(k);
+	//small problems or most of the spectrum: full decomposition
+	if(2 * blockSize >= n){
+		RealMatrix vectors;
+		RealVector values;
+		eigensymm(A,vectors,values);
+		noalias(eigenVectors) = columns(vectors,0,k);
+		noalias(eigenValues) = subrange(values,0,k);
+		return 0;
+	}
+
+	RealMatrix symmetricA(n,n);
+	for (std::size_t i = 0; i < n; i++) {
+		for (std::size_t j = 0; j <= i; j++) {
+			symmetricA(i, j) = symmetricA(j, i) = A()(i, j);
+		}
+	}
+	//the basis vectors are stored as rows
+	RealMatrix Q(blockSize,n);
+	for(std::size_t i = 0; i != blockSize; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			Q(i,j) = Rng::gauss();
+		}
+	}
+	detail::orthonormalizeRows(Q);
+
+	RealMatrix AQ(blockSize,n);
+	RealMatrix H(blockSize,blockSize);
+	RealMatrix W;
+	RealVector theta;
+	RealMatrix X(blockSize,n);
+	RealMatrix AX(blockSize,n);
+	std::size_t iteration = 0;
+	while(true){
+		++iteration;
+		noalias(AQ) = prod(Q,symmetricA);
+		noalias(H) = prod(Q,trans(AQ));
+		eigensymm(H,W,theta);
+		//Ritz vectors and their images
+		noalias(X) = prod(trans(W),Q);
+		noalias(AX) = prod(trans(W),AQ);
+
+		double scale = std::max(std::abs(theta(0)), std::abs(theta(blockSize - 1)));
+		double residual = 0;
+		for(std::size_t i = 0; i != k; ++i){
+			residual = std::max(residual, norm_2(row(AX,i) - theta(i) * row(X,i)));
+		}
+		if(residual <= tolerance * scale || iteration == maxIterations)
+			break;
+		Q = AX;
+		detail::orthonormalizeRows(Q);
+	}
+	noalias(eigenVectors) = trans(rows(X,0,k));
+	noalias(eigenValues) = subrange(theta,0,k);
+	return iteration;
+}
+
 /** @}*/
 }}
 #endif
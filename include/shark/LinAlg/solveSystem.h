@@ -317,6 +317,140 @@ void approxsolveSymmPosDefSystemInPlace(
 	swap(x,b);
 }
 
+/// \brief Preconditioner which does nothing, used by conjugateGradient when no preconditioner is given.
+struct IdentityPreconditioner{
+	template<class MatR, class MatZ>
+	void operator()(MatR const& R, MatZ& Z)const{
+		Z = R;
+	}
+};
+
+namespace detail{
+/// \brief Orthonormalizes the columns of P and removes columns which are numerically linearly dependent.
+///
+/// Uses modified Gram-Schmidt with reorthogonalization, choosing the column with the largest remaining
+/// norm first. A column is removed when less than tolerance of its initial norm remains.
+template<class MatP>
+void orthonormalizeColumnsWithDeflation(MatP& P, double tolerance){
+	typedef typename MatP::value_type value_type;
+	std::size_t k = P.size2();
+	matrix<value_type> PT = trans(P);
+	vector<value_type> remaining(k);
+	for(std::size_t i = 0; i != k; ++i){
+		value_type norm = norm_2(row(PT,i));
+		if(norm > 0)
+			row(PT,i) /= norm;
+		remaining(i) = norm > 0? 1: 0;
+	}
+	std::vector<std::size_t> selected;
+	for(std::size_t s = 0; s != k; ++s){
+		std::size_t p = arg_max(remaining);
+		if(remaining(p) <= tolerance) break;
+		remaining(p) = 0;
+		for(std::size_t t = 0; t != selected.size(); ++t)//second pass of Gram-Schmidt
+			noalias(row(PT,p)) -= inner_prod(row(PT,p),row(PT,selected[t])) * row(PT,selected[t]);
+		row(PT,p) /= norm_2(row(PT,p));
+		selected.push_back(p);
+		for(std::size_t i = 0; i != k; ++i){
+			if(remaining(i) <= 0) continue;
+			noalias(row(PT,i)) -= inner_prod(row(PT,i),row(PT,p)) * row(PT,p);
+			remaining(i) = norm_2(row(PT,i));
+		}
+	}
+	ensure_size(P,P.size1(),selected.size());
+	for(std::size_t i = 0; i != selected.size(); ++i)
+		noalias(column(P,i)) = row(PT,selected[i]);
+}
+}
+
+/// \brief Approximates the solution of the systems AX=B with the preconditioned block conjugate gradient method.
+///
+/// In contrast to approxsolveSymmPosDefSystem, the symmetric positive definite matrix A is never accessed directly.
+/// Instead, A is an operator which is called as A(P,Q) and has to compute Q=AP for an n x k matrix P.
+/// This allows to solve systems with matrices which are too large to be stored, for example kernel matrices
+/// which are computed on the fly (see KernelMatrixOperator). Similarly, the preconditioner is called
+/// as M(R,Z) and has to compute an approximation of \f$ Z= A^{-1}R \f$. It must be symmetric positive definite.
+///
+/// All k right hand sides are solved together by block conjugate gradients. Thus A is applied to k vectors
+/// at once and the search space is shared between the systems, which often reduces the number of iterations.
+/// Directions which become linearly dependent, for example because a system has already converged, are removed.
+///
+/// The algorithm stops after the maximum number of iterations is exceeded or when for all
+/// columns the max-norm of the residual \f$ R= B-AX\f$ is smaller than epsilon.
+///
+/// \param A the operator computing the product with the positive definite n x n-Matrix
+/// \param M the preconditioner, use IdentityPreconditioner if none is needed
+/// \param X the n x k solution matrix
+/// \param B the n x k right hand side
+/// \param epsilon stopping criterium for the residual
+/// \param initialSolution if this is true, X stores an initial guess of the solution
+/// \param maxIterations the maximum number of iterations, 0 means n
+/// \return the number of iterations performed
+template<class Operator, class Preconditioner, class MatX, class MatB>
+std::size_t conjugateGradient(
+	Operator const& A,
+	Preconditioner const& M,
+	matrix_expression<MatX, cpu_tag>& X,
+	matrix_expression<MatB, cpu_tag> const& B,
+	double epsilon = 1.e-10,
+	bool initialSolution = false,
+	std::size_t maxIterations = 0
+){
+	typedef typename MatX::value_type value_type;
+	std::size_t n = B().size1();
+	std::size_t k = B().size2();
+	std::size_t maxIt = (maxIterations == 0)? n: maxIterations;
+
+	matrix<value_type> R = B;//current residuals
+	if(initialSolution){
+		SIZE_CHECK(X().size1() == n);
+		SIZE_CHECK(X().size2() == k);
+		matrix<value_type> AX;
+		A(matrix<value_type>(X), AX);
+		noalias(R) -= AX;
+	}else{
+		ensure_size(X,n,k);
+		X().clear();
+	}
+
+	matrix<value_type> Z(n,k);//preconditioned residuals
+	matrix<value_type> P;//search directions
+	matrix<value_type> Q;//stores AP
+	matrix<value_type> PAP;//Cholesky factor of P^TAP
+	std::size_t iter = 0;
+	for(; iter != maxIt; ++iter){
+		bool converged = true;
+		for(std::size_t j = 0; j != k; ++j){
+			if(norm_inf(column(R,j)) >= epsilon)
+				converged = false;
+		}
+		if(converged) break;
+
+		//new search directions, conjugate to the previous ones
+		M(R,Z);
+		if(iter != 0){
+			matrix<value_type> beta = prod(trans(Q),Z);
+			solveTriangularCholeskyInPlace<SolveAXB>(PAP,beta);
+			noalias(Z) -= prod(P,beta);
+		}
+		P = Z;
+		//directions which are linearly dependent, e.g. because a system has converged, are removed
+		detail::orthonormalizeColumnsWithDeflation(P,1.e-8);
+		if(P.size2() == 0) break;
+		A(P,Q);
+		matrix<value_type> G = prod(trans(P),Q);
+		PAP.resize(G.size1(),G.size2());
+		choleskyDecomposition(G,PAP);
+
+		//minimize the error along the search directions
+		matrix<value_type> alpha = prod(trans(P),R);
+		solveTriangularCholeskyInPlace<SolveAXB>(PAP,alpha);
+		noalias(X()) += prod(P,alpha);
+		noalias(R) -= prod(Q,alpha);
+	}
+	return iter;
+}
+
 /** @}*/
 }}
 
@@ -140,7 +140,7 @@ public:
 
 protected:
 	/// Compute unnormalized membership from distance.
-	/// The default implementation is to return exp(-distance)
+	/// The default implementation is to return 1/distance
 	SHARK_EXPORT_SYMBOL virtual double membershipKernel(double dist) const;
 
 	/// centroid vectors
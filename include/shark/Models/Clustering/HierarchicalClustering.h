@@ -38,6 +38,7 @@
 
 #include <shark/Models/Clustering/AbstractClustering.h>
 #include <shark/Models/Trees/BinaryTree.h>
+#include <shark/Core/OpenMP.h>
 
 
 namespace shark {
@@ -86,10 +87,12 @@ public:
 	}
 
 	/// Return the best matching cluster for very pattern in the batch.
+	///
+	/// The patterns descend the tree independently and in parallel.
 	BatchOutputType hardMembership(BatchInputType const& patterns) const{
 		std::size_t numPatterns = boost::size(patterns);
 		BatchOutputType memberships(numPatterns);
-		for(std::size_t i = 0; i != numPatterns; ++i){
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numPatterns; ++i){
 			tree_type const* tree = mep_tree;
 			memberships(i) = 0;
 			while (tree->hasChildren()){
@@ -215,5 +215,137 @@ RealVector calculateKernelMatrixParameterDerivative(
 	return kernelGradient;
 }
 
+/// \brief Efficiently calculates the weighted derivative of a mixed Kernel Gram Matrix w.r.t the Kernel Parameters
+///
+/// The formula is \f$  \sum_i \sum_j w_{ij} k(x_i,y_j)\f$ where w_ij are the weights of the gradient,
+/// x_i are the points of the first and y_j the points of the second dataset. In contrast to
+/// calculateKernelMatrixParameterDerivative the weights need not be symmetric.
+///  \param kernel the kernel for which to calculate the kernel gram matrix
+///  \param dataset1 the set of points corresponding to rows of the Gram matrix
+///  \param dataset2 the set of points corresponding to columns of the Gram matrix
+///  \param weights the weights of the derivative
+///  \return the weighted derivative w.r.t the parameters.
+template<class InputType,class WeightMatrix>
+RealVector calculateMixedKernelMatrixParameterDerivative(
+	AbstractKernelFunction<InputType> const& kernel,
+	Data<InputType> const& dataset1,
+	Data<InputType> const& dataset2,
+	WeightMatrix const& weights
+){
+	SIZE_CHECK(weights.size1() == dataset1.numberOfElements());
+	SIZE_CHECK(weights.size2() == dataset2.numberOfElements());
+	std::size_t kp = kernel.numberOfParameters();
+	RealMatrix block;
+	RealVector kernelGradient(kp,0.0);
+	RealVector blockGradient(kp);
+	boost::shared_ptr<State> state = kernel.createState();
+	std::size_t startX = 0;
+	for (std::size_t i=0; i<dataset1.numberOfBatches(); i++){
+		std::size_t sizeX=shark::size(dataset1.batch(i));
+		std::size_t startY = 0;
+		for (std::size_t j=0; j < dataset2.numberOfBatches(); j++){
+			std::size_t sizeY=shark::size(dataset2.batch(j));
+			kernel.eval(dataset1.batch(i), dataset2.batch(j),block,*state);
+			kernel.weightedParameterDerivative(
+				dataset1.batch(i), dataset2.batch(j),
+				subrange(weights,startX,startX+sizeX,startY,startY+sizeY),
+				*state,
+				blockGradient
+			);
+			kernelGradient += blockGradient;
+			startY+= sizeY;
+		}
+		startX+=sizeX;
+	}
+	return kernelGradient;
+}
+
+/// \brief Calculates a low-rank factor of the kernel gram matrix using a pivoted incomplete Cholesky decomposition.
+///
+/// Computes an n x m matrix L with \f$ K \approx LL^T \f$. In every step the point with the largest
+/// residual diagonal is chosen as pivot and only its kernel column is evaluated, so the
+/// decomposition needs O(nm) kernel evaluations and O(nm^2) time instead of the full gram matrix.
+/// The decomposition stops when m reaches maxRank or when all residual diagonal entries are
+/// at most tolerance.
+///
+/// The rows of L belonging to the pivots form the lower triangular Cholesky factor \f$ L_I \f$ of the
+/// kernel matrix of the pivots, thus \f$ LL^T = K_{nI} K_{II}^{-1} K_{In} \f$ is the Nyström approximation
+/// using the pivots as landmarks.
+///  \param kernel the kernel for which to approximate the kernel gram matrix
+///  \param dataset the set of points used in the gram matrix
+///  \param L the resulting low-rank factor
+///  \param maxRank the maximum number of columns of L
+///  \param tolerance the decomposition stops if no residual diagonal element is larger
+///  \return the indices of the chosen pivots in the order they were selected
+template<class InputType>
+std::vector<std::size_t> calculateIncompleteCholeskyFactor(
+	AbstractKernelFunction<InputType> const& kernel,
+	Data<InputType> const& dataset,
+	RealMatrix& L,
+	std::size_t maxRank,
+	double tolerance = 1.e-10
+){
+	std::size_t B = dataset.numberOfBatches();
+	std::vector<std::size_t> batchStart(B+1,0);
+	for(std::size_t i = 1; i != B+1; ++i){
+		batchStart[i] = batchStart[i-1]+ boost::size(dataset.batch(i-1));
+	}
+	std::size_t N  = batchStart[B];
+	std::size_t maxColumns = std::min(maxRank,N);
+
+	//residual diagonal of the kernel matrix
+	RealVector residual(N);
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)B; ++b){
+		for(std::size_t k = batchStart[b]; k != batchStart[b+1]; ++k){
+			typename Data<InputType>::const_element_reference x = get(dataset.batch(b),k-batchStart[b]);
+			residual(k) = kernel.eval(x,x);
+		}
+	}
+
+	L.resize(N,maxColumns);
+	L.clear();
+	std::vector<std::size_t> pivots;
+	RealVector kernelColumn(N);
+	for(std::size_t j = 0; j != maxColumns; ++j){
+		std::size_t p = arg_max(residual);
+		double pivotValue = residual(p);
+		if(pivotValue <= tolerance) break;
+		pivots.push_back(p);
+
+		//evaluate the kernel column of the pivot
+		std::vector<InputType> pivotPoint(1,dataset.element(p));
+		typename Batch<InputType>::type pivotBatch = createBatch<InputType>(pivotPoint);
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)B; ++b){
+			RealMatrix block = kernel(dataset.batch(b),pivotBatch);
+			noalias(subrange(kernelColumn,batchStart[b],batchStart[b+1])) = column(block,0);
+		}
+
+		//orthogonalize against the previous columns
+		double pivotSqrt = std::sqrt(pivotValue);
+		if(j != 0){
+			noalias(kernelColumn) -= prod(columns(L,0,j),subrange(row(L,p),0,j));
+		}
+		noalias(column(L,j)) = kernelColumn/pivotSqrt;
+		//the pivots are interpolated exactly, which keeps the rows of the pivots triangular
+		for(std::size_t k = 0; k != pivots.size()-1; ++k){
+			L(pivots[k],j) = 0.0;
+		}
+		L(p,j) = pivotSqrt;
+
+		noalias(residual) -= sqr(column(L,j));
+		for(std::size_t k = 0; k != N; ++k){
+			residual(k) = std::max(residual(k),0.0);
+		}
+		for(std::size_t k = 0; k != pivots.size(); ++k){
+			residual(pivots[k]) = 0.0;
+		}
+	}
+	if(pivots.size() != maxColumns){
+		RealMatrix factor = columns(L,0,pivots.size());
+		L.swap(factor);
+	}
+	return pivots;
+}
+
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,186 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Binary tree of the clusters found by agglomerative clustering.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_TREES_AGGLOMERATIVETREE_H
+#define SHARK_MODELS_TREES_AGGLOMERATIVETREE_H
+
+
+#include <shark/Models/Trees/BinaryTree.h>
+#include <shark/Algorithms/AgglomerativeClustering.h>
+#include <shark/Data/DataView.h>
+#include <shark/LinAlg/Base.h>
+
+namespace shark {
+
+
+///
+/// \brief Binary tree of the clusters found by agglomerative clustering.
+///
+/// \par
+/// The tree is built from the merges returned by agglomerativeClustering.
+/// The dendrogram is cut such that the tree has the given number of leaves,
+/// one for each of the largest clusters. Every node splits its space by the
+/// hyperplane halfway between the centroids of its two child clusters,
+/// thus a point descends the tree to the child with the closer centroid.
+/// Used with HierarchicalClustering, this gives a clustering model with the
+/// clusters found by agglomerative clustering.
+///
+/// \par
+/// The index list is ordered such that each node covers the points
+/// of its cluster.
+///
+template <class VectorType = RealVector>
+class AgglomerativeTree : public BinaryTree<VectorType>
+{
+	typedef BinaryTree<VectorType> base_type;
+public:
+	/// \brief Construct the tree from the result of agglomerative clustering.
+	///
+	/// \param dataset            the clustered data
+	/// \param merges             the merges returned by agglomerativeClustering
+	/// \param numberOfClusters   number of leaves of the tree
+	AgglomerativeTree(
+		Data<VectorType> const& dataset,
+		std::vector<ClusterMerge> const& merges,
+		std::size_t numberOfClusters
+	): base_type(dataset.numberOfElements()){
+		SHARK_CHECK(merges.size() + 1 == m_size, "[AgglomerativeTree] the merges do not belong to the dataset");
+		SHARK_CHECK(numberOfClusters >= 1 && numberOfClusters <= m_size, "[AgglomerativeTree] invalid number of clusters");
+		//order the points such that every cluster is a contiguous range
+		std::size_t pos = 0;
+		std::vector<std::size_t> stack(1, 2*m_size - 2);
+		while(!stack.empty()){
+			std::size_t cluster = stack.back();
+			stack.pop_back();
+			if(cluster < m_size){
+				mp_indexList[pos++] = cluster;
+			}else{
+				stack.push_back(merges[cluster - m_size].right);
+				stack.push_back(merges[cluster - m_size].left);
+			}
+		}
+		DataView<Data<VectorType> const> points(dataset);
+		buildTree(points, merges, 2*m_size - 2, 2*m_size - numberOfClusters);
+	}
+
+	/// \par
+	/// Compute the squared Euclidean distance of
+	/// this cell to the given reference point, or
+	/// alternatively a lower bound on this value.
+	double squaredDistanceLowerBound(VectorType const& reference) const{
+		double dist = 0.0;
+		AgglomerativeTree const* t = this;
+		AgglomerativeTree const* p = (AgglomerativeTree const*)mep_parent;
+		while (p != NULL)
+		{
+			double v = p->distanceFromPlane(reference);
+			if (t == p->mp_right) 
+				v = -v;
+			if (v > dist) 
+				dist = v;
+			t = p;
+			p = (AgglomerativeTree const*)p->mep_parent;
+		}
+		return dist * dist;
+	}
+
+	/// centroid of the points in this node
+	VectorType const& centroid()const{
+		return m_centroid;
+	}
+
+protected:
+	using base_type::mep_parent;
+	using base_type::mp_left;
+	using base_type::mp_right;
+	using base_type::mp_indexList;
+	using base_type::m_size;
+	using base_type::m_nodes;
+	using base_type::m_threshold;
+
+	/// (internal) construction of a non-root node
+	AgglomerativeTree(AgglomerativeTree* parent, std::size_t* list, std::size_t size)
+	: base_type(parent, list, size){}
+
+	/// (internal) construction method: creates the sub-tree of the given cluster.
+	/// Clusters with index smaller than firstInternal become leaves.
+	template<class Points>
+	void buildTree(
+		Points const& points, std::vector<ClusterMerge> const& merges,
+		std::size_t cluster, std::size_t firstInternal
+	){
+		std::size_t n = merges.size() + 1;
+		m_centroid = points[mp_indexList[0]];
+		for(std::size_t i = 1; i != m_size; ++i){
+			noalias(m_centroid) += points[mp_indexList[i]];
+		}
+		m_centroid /= double(m_size);
+		if(cluster < firstInternal){
+			m_nodes = 1;
+			return;
+		}
+
+		ClusterMerge const& merge = merges[cluster - n];
+		std::size_t leftSize = merge.left < n? 1 : merges[merge.left - n].size;
+		AgglomerativeTree* left = new AgglomerativeTree(this, mp_indexList, leftSize);
+		AgglomerativeTree* right = new AgglomerativeTree(this, mp_indexList + leftSize, m_size - leftSize);
+		mp_left = left;
+		mp_right = right;
+		left->buildTree(points, merges, merge.left, firstInternal);
+		right->buildTree(points, merges, merge.right, firstInternal);
+		m_nodes = 1 + mp_left->nodes() + mp_right->nodes();
+
+		//the separating hyperplane is halfway between the centroids of the children
+		m_normal = right->m_centroid - left->m_centroid;
+		double factor = 1.0 / norm_2(m_normal);
+		if (! (boost::math::isfinite)(factor))
+			factor = 1.0;
+		m_normal *= factor;
+		m_threshold = 0.5 * inner_prod(m_normal, left->m_centroid + right->m_centroid);
+	}
+
+	/// function describing the separating hyperplane
+	double funct(VectorType const& reference) const{ 
+		return inner_prod(m_normal, reference);
+	}
+
+	/// normal of the separating hyperplane
+	VectorType m_normal;
+	/// centroid of the points in this node
+	VectorType m_centroid;
+};
+
+
+}
+#endif
@@ -0,0 +1,344 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       KD-tree stored in flat arrays for batched k-nearest neighbor queries.
+ *
+ *
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_TREES_FLATKDTREE_H
+#define SHARK_MODELS_TREES_FLATKDTREE_H
+
+#include <shark/Data/Dataset.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Core/utility/KeyValuePair.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace shark {
+
+///
+/// \brief KD-tree stored in flat arrays
+///
+/// \par
+/// In contrast to the KDTree, which is a linked structure of nodes holding
+/// references to the points, this tree is a complete binary tree stored
+/// implicitly in arrays: the children of node i are the nodes 2i+1 and 2i+2
+/// and the leaves are the last numberOfLeaves() nodes.
+/// Every node stores the range of points it covers and the bounding box of these
+/// points. The lower and upper corners of the boxes are stored in two separate
+/// matrices with one row per node.
+///
+/// \par
+/// The points are copied into the tree and reordered such, that the points of a leaf
+/// are stored contiguously in memory. The leaves hold up to a fixed number of points,
+/// the bucket size. Thus a query touches only a few contiguous memory blocks, which makes
+/// the distance computations in the leaves cheap.
+///
+/// \par
+/// The tree is constructed by splitting the dimension with the largest extent of the
+/// bounding box at the median. It is meant for dense inputs in low dimensions.
+///
+class FlatKDTree{
+public:
+	typedef KeyValuePair<double,std::size_t> DistancePair;
+
+	/// \brief Construct the tree from data.
+	///
+	/// \param  dataset     the points to be stored in the tree
+	/// \param  bucketSize  maximum number of points in a leaf
+	template<class InputType>
+	FlatKDTree(Data<InputType> const& dataset, std::size_t bucketSize = 32){
+		SHARK_CHECK(bucketSize > 0, "[FlatKDTree] bucket size must be positive");
+		std::size_t n = dataset.numberOfElements();
+		SHARK_CHECK(n > 0, "[FlatKDTree] can not build a tree from an empty dataset");
+		std::size_t dim = dataDimension(dataset);
+
+		//copy the points in a matrix in the order of the dataset
+		RealMatrix points(n,dim);
+		std::size_t start = 0;
+		for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+			typename Batch<InputType>::type const& batch = dataset.batch(b);
+			std::size_t batchSize = shark::size(batch);
+			noalias(rows(points,start,start+batchSize)) = batch;
+			start += batchSize;
+		}
+
+		//the number of leaves is the smallest power of two such that every leaf holds
+		//at most bucketSize points
+		m_leaves = 1;
+		while(m_leaves * bucketSize < n)
+			m_leaves *= 2;
+		std::size_t nodes = 2 * m_leaves - 1;
+
+		m_begin.resize(nodes);
+		m_end.resize(nodes);
+		m_lower.resize(nodes,dim);
+		m_upper.resize(nodes,dim);
+		m_index.resize(n);
+		for(std::size_t i = 0; i != n; ++i)
+			m_index[i] = i;
+
+		//parents are stored before their children, so we can build the tree top-down in node order
+		m_begin[0] = 0;
+		m_end[0] = n;
+		for(std::size_t node = 0; node != nodes; ++node){
+			std::size_t begin = m_begin[node];
+			std::size_t end = m_end[node];
+			computeBox(node,points);
+			if(isLeaf(node)) continue;
+
+			std::size_t mid = begin + (end - begin) / 2;
+			m_begin[2 * node + 1] = begin;
+			m_end[2 * node + 1] = mid;
+			m_begin[2 * node + 2] = mid;
+			m_end[2 * node + 2] = end;
+			if(end - begin < 2) continue;
+
+			//split the dimension with the largest extent at the median
+			std::size_t splitDim = 0;
+			double extent = -1;
+			for(std::size_t j = 0; j != dim; ++j){
+				double e = m_upper(node,j) - m_lower(node,j);
+				if(e > extent){
+					extent = e;
+					splitDim = j;
+				}
+			}
+			std::nth_element(
+				m_index.begin() + begin, m_index.begin() + mid, m_index.begin() + end,
+				CoordinateLess(points,splitDim)
+			);
+		}
+
+		//finally store the points in leaf order
+		m_points.resize(n,dim);
+		for(std::size_t i = 0; i != n; ++i){
+			noalias(row(m_points,i)) = row(points,m_index[i]);
+		}
+	}
+
+	/// \brief Number of points stored in the tree.
+	std::size_t size()const{
+		return m_points.size1();
+	}
+
+	/// \brief Dimensionality of the points.
+	std::size_t dimension()const{
+		return m_points.size2();
+	}
+
+	/// \brief Number of nodes of the tree.
+	std::size_t numberOfNodes()const{
+		return m_begin.size();
+	}
+
+	/// \brief Number of leaves of the tree.
+	std::size_t numberOfLeaves()const{
+		return m_leaves;
+	}
+
+	/// \brief Returns whether the node is a leaf.
+	bool isLeaf(std::size_t node)const{
+		return node + 1 >= m_leaves;
+	}
+
+	/// \brief Lower corners of the bounding boxes, one row per node.
+	RealMatrix const& lower()const{
+		return m_lower;
+	}
+
+	/// \brief Upper corners of the bounding boxes, one row per node.
+	RealMatrix const& upper()const{
+		return m_upper;
+	}
+
+	/// \brief The points in leaf order.
+	RealMatrix const& points()const{
+		return m_points;
+	}
+
+	/// \brief Index in the original dataset of the i-th point in leaf order.
+	std::size_t index(std::size_t i)const{
+		return m_index[i];
+	}
+
+	/// \brief Computes the k nearest neighbors of every row of the query matrix.
+	///
+	/// The result is a linearized array of size queries.size1()*k: the first k entries are
+	/// the neighbors of the first query sorted by distance, the next k the neighbors of the second query and so on.
+	/// The key of each entry is the euclidean distance, the value the index of the point in the original dataset.
+	/// The queries are processed in parallel. Every thread uses one preallocated heap and node stack for all its queries.
+	template<class QueryMatrix>
+	std::vector<DistancePair> kNearest(
+		blas::matrix_expression<QueryMatrix, blas::cpu_tag> const& queries, std::size_t k
+	)const{
+		SIZE_CHECK(queries().size2() == dimension());
+		if(k > size())
+			throw SHARKEXCEPTION("[FlatKDTree::kNearest] k is larger than the number of points");
+		RealMatrix queryMatrix = queries();//dense copy so that rows can be accessed quickly
+		std::size_t numQueries = queryMatrix.size1();
+		std::vector<DistancePair> results(numQueries * k);
+
+		//buffers for every thread. The depth of the tree is at most log2(numberOfLeaves()),
+		//and at every level at most one node is pushed additionally to the stack.
+		std::size_t maxThreads = SHARK_NUM_THREADS;
+		std::size_t depth = 1;
+		for(std::size_t l = m_leaves; l > 1; l /= 2) ++depth;
+		std::vector<std::vector<DistancePair> > heaps(maxThreads, std::vector<DistancePair>(k));
+		std::vector<std::vector<DistancePair> > stacks(maxThreads, std::vector<DistancePair>(2 * depth));
+
+		SHARK_PARALLEL_FOR(int q = 0; q < (int)numQueries; ++q){
+			std::vector<DistancePair>& heap = heaps[SHARK_THREAD_NUM];
+			std::vector<DistancePair>& stack = stacks[SHARK_THREAD_NUM];
+			double const* query = &queryMatrix(q,0);
+			search(query, heap, stack);
+
+			//sort the heap ascending and store the distances
+			std::sort_heap(heap.begin(), heap.end());
+			for(std::size_t i = 0; i != k; ++i){
+				results[q * k + i].key = std::sqrt(heap[i].key);
+				results[q * k + i].value = heap[i].value;
+			}
+		}
+		return results;
+	}
+
+private:
+	///\brief Orders point indices by a single coordinate.
+	struct CoordinateLess{
+		CoordinateLess(RealMatrix const& points, std::size_t dim):m_points(points), m_dim(dim){}
+		bool operator()(std::size_t i, std::size_t j)const{
+			return m_points(i,m_dim) < m_points(j,m_dim);
+		}
+		RealMatrix const& m_points;
+		std::size_t m_dim;
+	};
+
+	///\brief Computes the bounding box of the points of a node.
+	void computeBox(std::size_t node, RealMatrix const& points){
+		std::size_t dim = points.size2();
+		if(m_begin[node] == m_end[node]){
+			//an empty leaf is never visited, but give it an empty box anyways
+			row(m_lower,node) = blas::repeat(std::numeric_limits<double>::max(),dim);
+			row(m_upper,node) = blas::repeat(-std::numeric_limits<double>::max(),dim);
+			return;
+		}
+		noalias(row(m_lower,node)) = row(points,m_index[m_begin[node]]);
+		noalias(row(m_upper,node)) = row(points,m_index[m_begin[node]]);
+		for(std::size_t i = m_begin[node] + 1; i != m_end[node]; ++i){
+			double const* point = &points(m_index[i],0);
+			double* lower = &m_lower(node,0);
+			double* upper = &m_upper(node,0);
+			for(std::size_t j = 0; j != dim; ++j){
+				lower[j] = std::min(lower[j],point[j]);
+				upper[j] = std::max(upper[j],point[j]);
+			}
+		}
+	}
+
+	///\brief Squared distance of the query to the bounding box of a node.
+	double boxDistanceSqr(double const* query, std::size_t node)const{
+		double const* lower = &m_lower(node,0);
+		double const* upper = &m_upper(node,0);
+		double dist = 0;
+		for(std::size_t j = 0; j != dimension(); ++j){
+			double below = lower[j] - query[j];
+			double above = query[j] - upper[j];
+			double d = std::max(0.0,std::max(below,above));
+			dist += d * d;
+		}
+		return dist;
+	}
+
+	///\brief Depth-first branch and bound search of the k nearest neighbors using a max-heap of squared distances.
+	void search(double const* query, std::vector<DistancePair>& heap, std::vector<DistancePair>& stack)const{
+		typedef std::vector<DistancePair>::iterator iterator;
+		std::size_t dim = dimension();
+		//all elements have the same maximum distance and thus already form a heap
+		std::fill(heap.begin(), heap.end(), DistancePair(std::numeric_limits<double>::max(), 0));
+		iterator heapStart = heap.begin();
+		iterator heapEnd = heap.end();
+		iterator biggest = heapEnd - 1;
+		//the stack stores (squared box distance, node) pairs
+		std::size_t top = 0;
+		stack[top++] = DistancePair(boxDistanceSqr(query, 0), 0);
+		while(top != 0){
+			DistancePair current = stack[--top];
+			//heap.front() is the distance of the current k-th nearest neighbor
+			if(current.key >= heap.front().key) continue;
+			std::size_t node = current.value;
+			if(isLeaf(node)){
+				for(std::size_t i = m_begin[node]; i != m_end[node]; ++i){
+					double const* point = &m_points(i,0);
+					double dist = 0;
+					for(std::size_t j = 0; j != dim; ++j){
+						double diff = point[j] - query[j];
+						dist += diff * diff;
+					}
+					if(dist < heap.front().key){
+						//same replacement scheme as in SimpleNearestNeighbors:
+						//move the largest element to the back, overwrite and restore the heap
+						std::pop_heap(heapStart, heapEnd);
+						biggest->key = dist;
+						biggest->value = m_index[i];
+						std::push_heap(heapStart, heapEnd);
+					}
+				}
+				continue;
+			}
+			//push the farther child first, such that the closer child is visited first
+			std::size_t left = 2 * node + 1;
+			std::size_t right = 2 * node + 2;
+			double distLeft = m_begin[left] == m_end[left] ? std::numeric_limits<double>::max() : boxDistanceSqr(query, left);
+			double distRight = m_begin[right] == m_end[right] ? std::numeric_limits<double>::max() : boxDistanceSqr(query, right);
+			if(distLeft < distRight){
+				stack[top++] = DistancePair(distRight, right);
+				stack[top++] = DistancePair(distLeft, left);
+			}else{
+				stack[top++] = DistancePair(distLeft, left);
+				stack[top++] = DistancePair(distRight, right);
+			}
+		}
+	}
+
+	RealMatrix m_points;               ///< points in leaf order
+	std::vector<std::size_t> m_index;  ///< index of each point in the original dataset
+	std::vector<std::size_t> m_begin;  ///< first point of each node
+	std::vector<std::size_t> m_end;    ///< one past the last point of each node
+	RealMatrix m_lower;                ///< lower corners of the bounding boxes, one row per node
+	RealMatrix m_upper;                ///< upper corners of the bounding boxes, one row per node
+	std::size_t m_leaves;              ///< number of leaves
+};
+
+}
+#endif
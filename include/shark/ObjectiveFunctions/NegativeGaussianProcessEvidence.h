@@ -64,6 +64,9 @@ namespace shark {
 /// The regularization parameter can be encoded in different ways.
 /// The exponential encoding is the proper choice for unconstraint optimization.
 /// Be careful not to mix up different encodings between trainer and evidence.
+///
+/// For large datasets the kernel matrix can be replaced by a low-rank approximation,
+/// see setLowRankApproximation. The trainer should then use the same approximation.
 template<class InputType = RealVector, class OutputType = RealVector, class LabelType = RealVector>
 class NegativeGaussianProcessEvidence : public SingleObjectiveFunction
 {
@@ -81,6 +84,7 @@ public:
 	): m_dataset(dataset)
 	, mep_kernel(kernel)
 	, m_unconstrained(unconstrained)
+	, m_rank(0), m_tolerance(1.e-10)
 	{
 		if (kernel->hasFirstParameterDerivative()) m_features |= HAS_FIRST_DERIVATIVE;
 		setThreshold(0.);
@@ -94,6 +98,25 @@ public:
 		return 1+ mep_kernel->numberOfParameters();
 	}
 
+	/// \brief Returns the maximum rank of the kernel matrix approximation, 0 if the exact kernel matrix is used.
+	std::size_t lowRankApproximation() const
+	{ return m_rank; }
+
+	/// \brief Evaluates the evidence using a low-rank approximation of the kernel matrix.
+	///
+	/// For rank > 0 the kernel matrix is replaced by the pivoted incomplete Cholesky approximation
+	/// \f$ LL^T \f$ with at most rank columns, see calculateIncompleteCholeskyFactor. The evidence
+	/// and its derivative are then computed in O(n rank^2) time and O(n rank) memory using the
+	/// matrix inversion lemma. The pivots are treated as fixed for the derivative, i.e. it is the
+	/// derivative of the Nyström approximation with the pivots as landmarks.
+	/// A rank of 0 uses the exact kernel matrix.
+	/// \param rank maximum rank of the approximation
+	/// \param tolerance the approximation stops early when the residual kernel diagonal is below this value
+	void setLowRankApproximation(std::size_t rank, double tolerance = 1.e-10){
+		m_rank = rank;
+		m_tolerance = tolerance;
+	}
+
 	/// Let \f$M\f$ denote the (kernel Gram) covariance matrix and
 	/// \f$t\f$ the label vector.  For the evidence we have: \f[ E= 1/2 \cdot [ -\log(\det(M)) - t^T M^{-1} t - N \log(2 \pi) ] \f]
 	double eval(const RealVector& parameters) const {
@@ -113,6 +136,8 @@ public:
 			betaInv = std::exp(betaInv); // for unconstraint optimization
 		mep_kernel->setParameterVector(kernelParams);
 		
+		if(m_rank != 0)
+			return -lowRankEvidence(betaInv,0,0);
 		
 		//generate kernel matrix and label vector
 		RealMatrix M = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
@@ -166,6 +191,18 @@ public:
 			betaInv = std::exp(betaInv); // for unconstraint optimization
 		mep_kernel->setParameterVector(kernelParams);
 		
+		if(m_rank != 0){
+			RealVector kernelGradient;
+			double betaInvDerivative = 0;
+			double e = lowRankEvidence(betaInv,&kernelGradient,&betaInvDerivative);
+			if(m_unconstrained) 
+				betaInvDerivative *= betaInv;
+			blas::init(derivative)<<kernelGradient,betaInvDerivative;
+			derivative *= -1.0;
+			for(std::size_t i=0; i<derivative.size(); i++) 
+				if(std::abs(derivative(i)) < m_derivativeThresholds(i)) derivative(i) = 0;
+			return -e;
+		}
 		
 		//generate kernel matrix and label vector
 		RealMatrix M = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
@@ -241,6 +278,72 @@ public:
 		
 
 private:
+	/// \brief Computes the evidence and optionally its derivative using the approximation M = betaInv I + LL^T.
+	///
+	/// With \f$ A = \beta^{-1} I + L^TL \f$ the matrix inversion lemma gives
+	/// \f$ M^{-1} = \beta (I - LA^{-1}L^T) \f$ and \f$ \det(M) = \beta^{m-n}\det(A) \f$.
+	/// For the derivative, \f$ LL^T = K_{nI}K_{II}^{-1}K_{In} \f$ is differentiated with fixed pivots I.
+	double lowRankEvidence(double betaInv, RealVector* kernelGradient, double* betaInvDerivative)const{
+		std::size_t N  = m_dataset.numberOfElements(); 
+		RealVector t = column(createBatch<RealVector>(m_dataset.labels().elements()),0);
+		RealMatrix L;
+		std::vector<std::size_t> pivots = calculateIncompleteCholeskyFactor(
+			*mep_kernel,m_dataset.inputs(),L,m_rank,m_tolerance
+		);
+		std::size_t m = pivots.size();
+		
+		RealMatrix A = prod(trans(L),L);
+		for(std::size_t i = 0; i != m; ++i)
+			A(i,i) += betaInv;
+		RealMatrix choleskyFactor(m,m);
+		choleskyDecomposition(A, choleskyFactor);
+		A = RealMatrix();
+		
+		//t^T M^-1 t = beta (t^Tt - u^T A^-1 u) with u = L^T t
+		RealVector u = prod(trans(L),t);
+		RealVector v = u;
+		blas::solveTriangularCholeskyInPlace<blas::SolveAXB>(choleskyFactor,v);
+		double logDetM = (N-m) * std::log(betaInv) + 2* trace(log(choleskyFactor));
+		double e = 0.5 * (-logDetM - (norm_sqr(t) - inner_prod(u,v))/betaInv - N * std::log(2.0 * M_PI));
+		if(!kernelGradient)
+			return e;
+		
+		//z = M^-1 t and P = A^-1 L^T = L^T M^-1
+		RealVector z = (t - prod(L,v))/betaInv;
+		RealMatrix P = trans(L);
+		blas::solveTriangularCholeskyInPlace<blas::SolveAXB>(choleskyFactor,P);
+		
+		//as in the exact case dE/da = tr(W dM/da) with W = -M^-1 +zz^T. Using 
+		//dM/da = dK_{nI} L_I^{-T} L^T + L L_I^{-1} dK_{In} - L L_I^{-1} dK_{II} L_I^{-T} L^T
+		//we get dE/da = sum_ij S_ij dK(x_Ii,x_j) - 1/2 sum_ij D_ij dK(x_Ii,x_Ij)
+		//with S = L_I^{-T}L^TW and D = S L L_I^{-1}. We store S transposed.
+		RealMatrix pivotFactor(m,m);
+		std::vector<InputType> pivotPoints(m);
+		for(std::size_t i = 0; i != m; ++i){
+			noalias(row(pivotFactor,i)) = row(L,pivots[i]);
+			pivotPoints[i] = m_dataset.inputs().element(pivots[i]);
+		}
+		RealVector Lz = prod(trans(L),z);
+		RealMatrix St = outer_prod(z,Lz);
+		noalias(St) -= trans(P);
+		blas::solveTriangularSystemInPlace<blas::SolveXAB,blas::lower>(pivotFactor,St);
+		RealMatrix D = prod(trans(St),L);
+		blas::solveTriangularSystemInPlace<blas::SolveXAB,blas::lower>(pivotFactor,D);
+		RealMatrix symmetricD = 0.5*(D+trans(D));
+		
+		Data<InputType> landmarks = createDataFromRange(pivotPoints);
+		RealMatrix S = trans(St);
+		*kernelGradient = calculateMixedKernelMatrixParameterDerivative(*mep_kernel,landmarks,m_dataset.inputs(),S);
+		noalias(*kernelGradient) -= 0.5*calculateKernelMatrixParameterDerivative(*mep_kernel,landmarks,symmetricD);
+		
+		//dE/dC = 1/2 tr(W) = 1/2 (-tr(M^-1) + z^Tz) with tr(M^-1) = beta (N - tr(LP))
+		double traceLP = 0;
+		for(std::size_t i = 0; i != N; ++i)
+			traceLP += inner_prod(row(L,i),column(P,i));
+		*betaInvDerivative = 0.5 * (-(N - traceLP)/betaInv + norm_sqr(z));
+		return e;
+	}
+
 	/// pointer to external data set
 	DatasetType m_dataset;
 
@@ -254,6 +357,11 @@ private:
 	/// considered. This is useful for unconstraint
 	/// optimization. The default value is false.
 	bool m_unconstrained; 
+
+	/// maximum rank of the kernel matrix approximation, 0 for the exact kernel matrix
+	std::size_t m_rank;
+	/// tolerance of the incomplete Cholesky decomposition
+	double m_tolerance;
 };
 
 
@@ -36,6 +36,7 @@
 #include <shark/Unsupervised/RBM/Neuronlayers/BinaryLayer.h>
 #include <shark/Unsupervised/RBM/Sampling/GibbsOperator.h>
 #include <shark/Unsupervised/RBM/Sampling/TemperedMarkovChain.h>
+#include <shark/Unsupervised/RBM/Sampling/BatchedTemperedMarkovChain.h>
 #include <shark/Unsupervised/RBM/Sampling/MarkovChain.h>
 
 #include <shark/Unsupervised/RBM/GradientApproximations/ContrastiveDivergence.h>
@@ -48,10 +49,12 @@ typedef RBM<BinaryLayer,BinaryLayer, Rng::rng_type> BinaryRBM;
 typedef GibbsOperator<BinaryRBM> BinaryGibbsOperator;
 typedef MarkovChain<BinaryGibbsOperator> BinaryGibbsChain;
 typedef TemperedMarkovChain<BinaryGibbsOperator> BinaryPTChain;
+typedef BatchedTemperedMarkovChain<BinaryGibbsOperator> BinaryBatchedPTChain;
 
 typedef MultiChainApproximator<BinaryGibbsChain> BinaryPCD;
 typedef ContrastiveDivergence<BinaryGibbsOperator> BinaryCD;
 typedef SingleChainApproximator<BinaryPTChain> BinaryParallelTempering;
+typedef MultiChainApproximator<BinaryBatchedPTChain> BinaryBatchedParallelTempering;
 }
 
 #endif
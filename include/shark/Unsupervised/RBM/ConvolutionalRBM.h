@@ -31,8 +31,10 @@
 #define SHARK_UNSUPERVISED_RBM_CONVOLUTIONALRBM_H
 
 #include <shark/Models/AbstractModel.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Unsupervised/RBM/Energy.h>
 #include <shark/Unsupervised/RBM/Impl/ConvolutionalEnergyGradient.h>
+#include <shark/Unsupervised/RBM/Impl/Convolution.h>
 
 #include <sstream>
 #include <boost/serialization/string.hpp>
@@ -90,7 +92,9 @@ private:
 			noalias(output) = hiddenNeurons().mean(statisticsBatch);
 		}
 		else{
-			hiddenNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			SHARK_CRITICAL_REGION{
+				hiddenNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			}
 		}
 	}
 
@@ -111,7 +115,9 @@ private:
 			noalias(output) = visibleNeurons().mean(statisticsBatch);
 		}
 		else{
-			visibleNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			SHARK_CRITICAL_REGION{
+				visibleNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			}
 		}
 	}
 public:
@@ -193,10 +199,10 @@ public:
 		return m_filters.size();
 	}
 	std::size_t filterSize1()const{
-		return m_filters.size1();
+		return m_filters[0].size1();
 	}
 	std::size_t filterSize2()const{
-		return m_filters.size2();
+		return m_filters[0].size2();
 	}
 	
 	std::size_t inputSize1()const{
@@ -209,10 +215,10 @@ public:
 	
 	
 	std::size_t responseSize1()const{
-		return m_inputSize1-m_filters.size1()+1;
+		return m_inputSize1-filterSize1()+1;
 	}
 	std::size_t responseSize2()const{
-		return m_inputSize2-m_filters.size2()+1;
+		return m_inputSize2-filterSize2()+1;
 	}
 	
 	///\brief Returns the weight matrix connecting the layers.
@@ -282,65 +288,53 @@ public:
 	
 	///\brief Calculates the input of the hidden neurons given the state of the visible in a batch-vise fassion.
 	///
+	///The correlation of every image with all filters is lowered to a single matrix-matrix product:
+	///the patches of the image are stored as rows of a matrix (im2col) which is multiplied with the matrix of filters.
+	///
 	///@param inputs the batch of vectors the input of the hidden neurons is stored in
 	///@param visibleStates the batch of states of the visible neurons
 	void inputHidden(RealMatrix& inputs, RealMatrix const& visibleStates)const{
 		SIZE_CHECK(visibleStates.size1() == inputs.size1());
 		SIZE_CHECK(inputs.size2() == numberOfHN());
 		SIZE_CHECK( visibleStates.size2() == numberOfVN());
-		inputs.clear();
-
+		
+		RealMatrix filters = detail::filterMatrix(m_filters);
+		RealMatrix patches;
 		for(std::size_t i= 0; i != inputs.size1();++i){
 			blas::dense_matrix_adaptor<double const> visibleState = 
 				to_matrix(row(visibleStates,i),inputSize1(),inputSize2());
 			blas::dense_matrix_adaptor<double> responses = 
-				to_matrix(row(inputs,i),m_filters.size()*responseSize1(),responseSize2());
+				to_matrix(row(inputs,i),numFilters(),responseSize1()*responseSize2());
 			
-			for (std::size_t x1=0; x1 != responseSize1(); ++x1) {
-				for (std::size_t x2=0; x2 != responseSize2(); ++x2) {
-					std::size_t end1= x1+m_filters.size1();
-					std::size_t end2= x2+m_filters.size2();
-					for(std::size_t f = 0; f != m_filters.size();++f){
-						responses(f*responseSize1()+x1,x2)=sum(m_filters[f]*subrange(visibleState,x1,end1,x2,end2));
-					}
-				}
-			}
+			detail::im2col(visibleState,filterSize1(),filterSize2(),patches);
+			noalias(responses) = prod(filters,trans(patches));
 		}
 	}
 
 
 	///\brief Calculates the input of the visible neurons given the state of the hidden.
 	///
+	///The full convolution of the responses with the filters is computed as the matrix-matrix product
+	///of the responses and the filters, the result of which is added to the image patch by patch (col2im).
+	///
 	///@param inputs the vector the input of the visible neurons is stored in
 	///@param hiddenStates the state of the hidden neurons
 	void inputVisible(RealMatrix& inputs, RealMatrix const& hiddenStates)const{
 		SIZE_CHECK(hiddenStates.size1() == inputs.size1());
 		SIZE_CHECK(inputs.size2() == numberOfVN());
 		SIZE_CHECK(hiddenStates.size2() == numberOfHN());
-		typedef blas::dense_matrix_adaptor<double> Response;
 		inputs.clear();
 		
-		//we slightly optimize this routine by checking whether the hiddens are 0 -
-		//this is likely when the hiddens are binary.
+		RealMatrix filters = detail::filterMatrix(m_filters);
+		RealMatrix patches(responseSize1()*responseSize2(),filterSize1()*filterSize2());
 		for(std::size_t i= 0; i != inputs.size1();++i){
 			blas::dense_matrix_adaptor<double const> hiddenState = 
-				to_matrix(row(hiddenStates,i),responseSize1()*m_filters.size(),responseSize2());
-			Response responses = 
+				to_matrix(row(hiddenStates,i),numFilters(),responseSize1()*responseSize2());
+			blas::dense_matrix_adaptor<double> responses = 
 				to_matrix(row(inputs,i),m_inputSize1,m_inputSize2);
 			
-			for (std::size_t x1=0; x1 != responseSize1(); ++x1) {
-				for (std::size_t x2=0; x2 != responseSize2(); ++x2) {
-					std::size_t end1= x1+m_filters.size1();
-					std::size_t end2= x2+m_filters.size2();
-					blas::matrix_range<Response> receptiveArea = subrange(responses,x1,end1,x2,end2);
-						
-					for(std::size_t f = 0; f != m_filters.size();++f){
-						double neuronResponse = hiddenState(f*responseSize1()+x1,x2);
-						if(neuronResponse == 0.0) continue;
-						noalias(receptiveArea) += neuronResponse * m_filters[f];
-					}
-				}
-			}
+			noalias(patches) = prod(trans(hiddenState),filters);
+			detail::col2imAdd(patches,filterSize1(),filterSize2(),responses);
 		}
 	}
 	
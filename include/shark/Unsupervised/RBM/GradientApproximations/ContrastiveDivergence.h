@@ -133,8 +133,15 @@ public:
 		std::size_t threads = std::min<std::size_t>(batchesForTraining,SHARK_NUM_THREADS);
 		std::size_t numBatches = batchesForTraining/threads;
 		
+		//every thread samples with its own random number stream, seeded from the rng of the RBM.
+		//this way sampling does not need to lock the shared generator.
+		std::vector<typename RBM::RngType::result_type> seeds(threads);
+		for(std::size_t t = 0; t != threads; ++t){
+			seeds[t] = mpe_rbm->rng()();
+		}
 		
 		SHARK_PARALLEL_FOR(int t = 0; t < (int)threads; ++t){
+			typename RBM::RngType rng(seeds[t]);
 			typename RBM::GradientType empiricalAverage(mpe_rbm);
 			typename RBM::GradientType modelAverage(mpe_rbm);
 			
@@ -152,15 +159,15 @@ public:
 				
 				visibleBatch.state = batch;
 				m_operator.precomputeHidden(hiddenBatch,visibleBatch,blas::repeat(1.0,batch.size1()));
-				m_operator.sampleHidden(hiddenBatch);
+				m_operator.sampleHidden(hiddenBatch,rng);
 				empiricalAverage.addVH(hiddenBatch,visibleBatch);
 				
 				for(std::size_t step = 0; step != m_k; ++step){
 					m_operator.precomputeVisible(hiddenBatch, visibleBatch,blas::repeat(1.0,batch.size1()));
-					m_operator.sampleVisible(visibleBatch);
+					m_operator.sampleVisible(visibleBatch,rng);
 					m_operator.precomputeHidden(hiddenBatch, visibleBatch,blas::repeat(1.0,batch.size1()));
 					if( step != m_k-1){
-						m_operator.sampleHidden(hiddenBatch);
+						m_operator.sampleHidden(hiddenBatch,rng);
 					}
 				}
 				modelAverage.addVH(hiddenBatch,visibleBatch);
@@ -144,7 +144,9 @@ public:
 		for(std::size_t i = 0; i != m_chains.size();++i){
 			swap(m_chains[i],m_chainOperator.samples());//set the current GibbsChain
 			m_chainOperator.step(m_k);//do the next step along the gibbs chain
-			modelAverage.addVH(m_chainOperator.samples().hidden, m_chainOperator.samples().visible);//update gradient
+			//update gradient. For tempered chains only the samples at beta=1 are used.
+			typename MarkovChainType::SampleBatch const& samples = m_chainOperator.modelSamples();
+			modelAverage.addVH(samples.hidden, samples.visible);
 			swap(m_chains[i],m_chainOperator.samples());//save the GibbsChain.
 		}
 		
@@ -0,0 +1,107 @@
+/*!
+ *
+ *
+ * \brief       Lowering of 2D convolutions to matrix-matrix products.
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_UNSUPERVISED_RBM_IMPL_CONVOLUTION_H
+#define SHARK_UNSUPERVISED_RBM_IMPL_CONVOLUTION_H
+
+#include <shark/LinAlg/Base.h>
+#include <vector>
+
+namespace shark{
+namespace detail{
+
+///\brief Stores every filter-sized patch of an image as a row of a matrix (im2col).
+///
+///The patch at position (x1,x2) is stored in row x1*responseSize2+x2, where responseSize2 = image.size2()-filterSize2+1.
+///The element (k1,k2) of the patch is stored in column k1*filterSize2+k2. Thus the valid correlation of the image
+///with a set of filters stored row-wise in a matrix F is prod(F,trans(patches)).
+template<class ImageMatrix>
+void im2col(
+	blas::matrix_expression<ImageMatrix, blas::cpu_tag> const& image,
+	std::size_t filterSize1, std::size_t filterSize2,
+	RealMatrix& patches
+){
+	std::size_t responseSize1 = image().size1()-filterSize1+1;
+	std::size_t responseSize2 = image().size2()-filterSize2+1;
+	patches.resize(responseSize1*responseSize2,filterSize1*filterSize2);
+	for (std::size_t x1=0; x1 != responseSize1; ++x1) {
+		for (std::size_t x2=0; x2 != responseSize2; ++x2) {
+			std::size_t patch = x1*responseSize2+x2;
+			for(std::size_t k1 = 0; k1 != filterSize1; ++k1){
+				for(std::size_t k2 = 0; k2 != filterSize2; ++k2){
+					patches(patch,k1*filterSize2+k2) = image()(x1+k1,x2+k2);
+				}
+			}
+		}
+	}
+}
+
+///\brief Adds every row of a matrix of patches to its position in an image, the adjoint of im2col.
+///
+///This is used for the full convolution of a response with the filters: given the patch contributions
+///prod(trans(responses),F), col2im sums all contributions belonging to the same pixel.
+template<class ImageMatrix>
+void col2imAdd(
+	RealMatrix const& patches,
+	std::size_t filterSize1, std::size_t filterSize2,
+	blas::matrix_expression<ImageMatrix, blas::cpu_tag>& image
+){
+	std::size_t responseSize1 = image().size1()-filterSize1+1;
+	std::size_t responseSize2 = image().size2()-filterSize2+1;
+	SIZE_CHECK(patches.size1() == responseSize1*responseSize2);
+	SIZE_CHECK(patches.size2() == filterSize1*filterSize2);
+	for (std::size_t x1=0; x1 != responseSize1; ++x1) {
+		for (std::size_t x2=0; x2 != responseSize2; ++x2) {
+			std::size_t patch = x1*responseSize2+x2;
+			for(std::size_t k1 = 0; k1 != filterSize1; ++k1){
+				for(std::size_t k2 = 0; k2 != filterSize2; ++k2){
+					image()(x1+k1,x2+k2) += patches(patch,k1*filterSize2+k2);
+				}
+			}
+		}
+	}
+}
+
+///\brief Stores a set of filters as rows of a matrix, the layout used by im2col.
+inline RealMatrix filterMatrix(std::vector<RealMatrix> const& filters){
+	std::size_t filterSize1 = filters[0].size1();
+	std::size_t filterSize2 = filters[0].size2();
+	RealMatrix result(filters.size(),filterSize1*filterSize2);
+	for(std::size_t f = 0; f != filters.size(); ++f){
+		for(std::size_t k1 = 0; k1 != filterSize1; ++k1){
+			for(std::size_t k2 = 0; k2 != filterSize2; ++k2){
+				result(f,k1*filterSize2+k2) = filters[f](k1,k2);
+			}
+		}
+	}
+	return result;
+}
+
+}}
+#endif
@@ -29,7 +29,8 @@
 #define SHARK_UNSUPERVISED_RBM_IMPL_CONVOLUTIONALENERGYGRADIENT_H
 
 #include <shark/LinAlg/Base.h>
-#include <shark/LinAlg/BLAS/matrix_set.hpp>
+#include <shark/LinAlg/Initialize.h>
+#include <shark/Unsupervised/RBM/Impl/Convolution.h>
 namespace shark{
 namespace detail{
 ///\brief The gradient of the energy averaged over a set of cumulative added samples.
@@ -43,7 +44,7 @@ class ConvolutionalEnergyGradient{
 public:	
 	ConvolutionalEnergyGradient(RBM const* rbm)
 	: mpe_rbm(rbm)
-	, m_deltaWeights(rbm->numFilters(),RealMatrix(rbm->filterSize1(), rbm->filterSize2(),0.0))
+	, m_deltaWeights(rbm->numFilters(),rbm->filterSize1() * rbm->filterSize2(),0.0)
 	, m_logWeightSum(-std::numeric_limits<double>::infinity()){
 		SHARK_CHECK(mpe_rbm != 0, "rbm is not allowed to be 0");
 		std::size_t const hiddenParameters = rbm->hiddenNeurons().numberOfParameters();
@@ -140,6 +141,7 @@ public:
 		noalias(m_deltaWeights) += weight * gradient.m_deltaWeights;
 		noalias(m_deltaBiasVisible) += weight * gradient.m_deltaBiasVisible;
 		noalias(m_deltaBiasHidden) += weight * gradient.m_deltaBiasHidden;
+		return *this;
 	}
 	
 	///\brief Calculates the expectation of the energy gradient with respect to p(h|v) for a complete Batch.
@@ -176,7 +178,7 @@ public:
 	///\brief Writes the derivatives of all parameters into a vector and returns it.
 	RealVector result()const{
 		RealVector derivative(mpe_rbm->numberOfParameters());
-		init(derivative) << matrixSet(m_deltaWeights),m_deltaBiasHidden,m_deltaBiasVisible;
+		init(derivative) << toVector(m_deltaWeights),m_deltaBiasHidden,m_deltaBiasVisible;
 		return derivative;
 	}
 	
@@ -190,32 +192,25 @@ public:
 	
 private:
 	RBM const* mpe_rbm; //structure of the corresponding RBM
-	std::vector<RealMatrix> m_deltaWeights; //stores the average of the derivatives with respect to the weights
+	RealMatrix m_deltaWeights; //stores the average of the derivatives with respect to the filters. Row i is filter i in row-major order.
 	RealVector m_deltaBiasHidden; //stores the average of the derivative with respect to the hidden biases
 	RealVector m_deltaBiasVisible; //stores the average of the derivative with respect to the visible biases
 	double m_logWeightSum; //log of sum of weights. Usually equal to the log of the number of samples used.
 	
 
+	///\brief Adds the correlation of every hidden response with the visible image to the filter derivative.
+	///
+	///For every sample this is a single matrix-matrix product of the responses with the patches of the image.
 	template<class MatrixH, class MatrixV>
 	void updateConnectionDerivative(MatrixH const& hiddens, MatrixV const& visibles){
-		
 		std::size_t numFilters = mpe_rbm->numFilters();
-		std::size_t responseSize1 = mpe_rbm->responseSize1();
-		std::size_t responseSize2 = mpe_rbm->responseSize2();
+		std::size_t responses = mpe_rbm->responseSize1()*mpe_rbm->responseSize2();
+		RealMatrix patches;
 		for(std::size_t i = 0; i != hiddens.size1();++i){
 			auto visible = to_matrix(row(visibles,i),mpe_rbm->inputSize1(),mpe_rbm->inputSize2());
-			auto hidden = to_matrix(row(hiddens,i),numFilters*responseSize1,responseSize2);
-			
-			for (std::size_t x1=0; x1 != responseSize1; ++x1) {
-				for(std::size_t x2=0; x2 != responseSize2; ++x2) {
-					std::size_t end1 = x1+mpe_rbm->filterSize1();
-					std::size_t end2 = x2+mpe_rbm->filterSize2();
-					for(std::size_t f = 0; f != numFilters;++f){
-						double val = hidden(f*responseSize1+x1,x2);
-						noalias(m_deltaWeights[f]) += subrange(visible,x1,end1,x2,end2)*val;
-					}
-				}
-			}
+			auto hidden = to_matrix(row(hiddens,i),numFilters,responses);
+			detail::im2col(visible,mpe_rbm->filterSize1(),mpe_rbm->filterSize2(),patches);
+			noalias(m_deltaWeights) += prod(hidden,patches);
 		}
 	}
 	
@@ -38,6 +38,7 @@
 #include <shark/Core/OpenMP.h>
 
 #include <boost/range/numeric.hpp>
+#include <vector>
 namespace shark {
 namespace detail{
 	
@@ -226,6 +227,72 @@ namespace detail{
 	}
 	
 
+	///\brief Computes the log importance weights of independent annealed importance sampling runs.
+	///
+	///Every run starts with a sample of the hidden units at the inverse temperature beta(K)=0, which can be drawn exactly,
+	///and then moves through the temperatures beta(K-1),...,beta(0) using one Gibbs step at every temperature.
+	///The runs are split into batches which are sampled in parallel. Every batch uses its own random number generator
+	///seeded from the generator of the RBM, thus the result does only depend on the seed and the batch size.
+	///
+	///@param rbm the RBM
+	///@param beta the decreasing sequence of inverse temperatures ending with 0
+	///@param logWeights the log importance weight for every run
+	///@param batchSize the number of runs sampled at once
+	template<class RBMType>
+	void annealedImportanceWeights(
+		RBMType& rbm,
+		RealVector const& beta,
+		RealVector& logWeights,
+		std::size_t batchSize
+	){
+		std::size_t temperatures = beta.size();
+		std::size_t runs = logWeights.size();
+		typedef typename RBMType::RngType Rng;
+		
+		GibbsOperator<RBMType> gibbsOperator(&rbm);
+		typedef typename GibbsOperator<RBMType>::HiddenSampleBatch Hidden;
+		typedef typename GibbsOperator<RBMType>::VisibleSampleBatch Visible;
+		
+		std::size_t numBatches = (runs + batchSize - 1) / batchSize;
+		std::vector<typename Rng::result_type> seeds(numBatches);
+		for(std::size_t b = 0; b != numBatches; ++b){
+			seeds[b] = rbm.rng()();
+		}
+		
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)numBatches; ++b){
+			std::size_t batchStart = b*batchSize;
+			std::size_t batchEnd = std::min(batchStart+batchSize, runs);
+			std::size_t curSize = batchEnd-batchStart;
+			Rng rng(seeds[b]);
+			Energy<RBMType> energy = rbm.energy();
+			
+			Hidden hidden(curSize,rbm.numberOfHN());
+			Visible visible(curSize,rbm.numberOfVN());
+			RealVector runLogWeights(curSize,0.0);
+			
+			//at beta=0 the hidden units are independent of the visible, so this is an exact sample
+			visible.state.clear();
+			gibbsOperator.precomputeHidden(hidden, visible,blas::repeat(beta(temperatures-1),curSize));
+			gibbsOperator.sampleHidden(hidden,rng);
+			
+			for(std::size_t k = temperatures-1; k != 0; --k){
+				//precomputeVisible also computes the input of the visible units needed for p(h)
+				gibbsOperator.precomputeVisible(hidden, visible,blas::repeat(beta(k-1),curSize));
+				noalias(runLogWeights) += energy.logUnnormalizedProbabilityHidden(
+					hidden.state, visible.input, blas::repeat(beta(k-1),curSize)
+				) - energy.logUnnormalizedProbabilityHidden(
+					hidden.state, visible.input, blas::repeat(beta(k),curSize)
+				);
+				//the last state is never used again, thus no transition at the target temperature
+				if(k == 1) break;
+				gibbsOperator.sampleVisible(visible,rng);
+				gibbsOperator.precomputeHidden(hidden, visible,blas::repeat(beta(k-1),curSize));
+				gibbsOperator.sampleHidden(hidden,rng);
+			}
+			noalias(subrange(logWeights,batchStart,batchEnd)) = runLogWeights;
+		}
+	}
+
 	///\brief updates the log partition with the Energy of another state
 	///
 	///Calculating the partition fucntion itself is not easy. Aside from the computational complexity, 
@@ -36,7 +36,7 @@
 #include <shark/Data/BatchInterfaceAdaptStruct.h>
 #include <shark/Rng/Bernoulli.h>
 #include <shark/Unsupervised/RBM/StateSpaces/TwoStateSpace.h>
-#include <shark/Core/OpenMP.h>
+#include <boost/random/uniform_01.hpp>
 namespace shark{
 
 ///\brief Layer of binary units taking values in {0,1}. 
@@ -123,6 +123,8 @@ public:
 	/// In the case of alpha=1, flip-the-state sampling is performed, which takes the last state into account and tries to do deterministically jump 
 	/// into states with higher probability. This is counterbalanced by a higher chance to jump back into a lower probability state in later steps. 
 	/// For alpha between 0 and 1 a mixture of both is performed.
+	/// The function does not lock the random number generator. When sampling from several threads,
+	/// every thread must use its own generator.
 	///
 	/// @param statistics sufficient statistics containing the probabilities of the neurons to be one
 	/// @param state the state vector that shell hold the sampled states
@@ -134,34 +136,37 @@ public:
 		SIZE_CHECK(statistics.size1() == state.size1());
 		SIZE_CHECK(statistics.size2() == state.size2());
 		
-		SHARK_CRITICAL_REGION{
-			Bernoulli<Rng> coinToss(rng,0.5);
-			if(alpha == 0.0){//special case: normal gibbs sampling
-				for(std::size_t s = 0; s != state.size1();++s){
-					for(std::size_t i = 0; i != state.size2();++i){
-						state(s,i) = coinToss(statistics(s,i));
-					}
+		if(alpha == 0.0){//special case: normal gibbs sampling
+			//first draw the uniform variates of the row, then threshold them
+			boost::uniform_01<double> uni;
+			for(std::size_t s = 0; s != state.size1();++s){
+				for(std::size_t i = 0; i != state.size2();++i){
+					state(s,i) = uni(rng);
+				}
+				for(std::size_t i = 0; i != state.size2();++i){
+					state(s,i) = state(s,i) < statistics(s,i);
 				}
 			}
-			else{//flip-the state sampling
-				for(size_t s = 0; s != state.size1(); ++s){
-					for (size_t i = 0; i != state.size2(); i++) {
-						double prob = statistics(s,i);
-						if (state(s,i) == 0) {
-							if (prob <= 0.5) {
-								prob = (1. - alpha) * prob + alpha * prob / (1. - prob);
-							} else {
-								prob = (1. - alpha) * prob  + alpha;
-							}
+		}
+		else{//flip-the state sampling
+			Bernoulli<Rng> coinToss(rng,0.5);
+			for(size_t s = 0; s != state.size1(); ++s){
+				for (size_t i = 0; i != state.size2(); i++) {
+					double prob = statistics(s,i);
+					if (state(s,i) == 0) {
+						if (prob <= 0.5) {
+							prob = (1. - alpha) * prob + alpha * prob / (1. - prob);
+						} else {
+							prob = (1. - alpha) * prob  + alpha;
+						}
+					} else {
+						if (prob >= 0.5) {
+							prob = (1. - alpha) * prob + alpha * (1. - (1. - prob) / prob);
 						} else {
-							if (prob >= 0.5) {
-								prob = (1. - alpha) * prob + alpha * (1. - (1. - prob) / prob);
-							} else {
-								prob = (1. - alpha) * prob;
-							}
+							prob = (1. - alpha) * prob;
 						}
-						state(s,i) = coinToss(prob);
 					}
+					state(s,i) = coinToss(prob);
 				}
 			}
 		}
@@ -37,7 +37,6 @@
 #include <shark/Core/IParameterizable.h>
 #include <shark/Core/Math.h>
 #include <shark/Data/BatchInterfaceAdaptStruct.h>
-#include <shark/Core/OpenMP.h>
 namespace shark{
 
 ///\brief A layer of Gaussian neurons.
@@ -102,6 +101,9 @@ public:
 	/// into states with higher probability. THIS IS NOT IMPLEMENTED YET and alpha is ignored!
 	///
 	///
+	/// The function does not lock the random number generator. When sampling from several threads,
+	/// every thread must use its own generator.
+	///
 	/// @param statistics sufficient statistics containing the mean of the conditional Gaussian distribution of the neurons
 	/// @param state the state matrix that will hold the sampled states
 	/// @param alpha factor changing from gibbs to flip-the state sampling. 0<=alpha<=1
@@ -112,12 +114,10 @@ public:
 		SIZE_CHECK(statistics.size1() == state.size1());
 		SIZE_CHECK(statistics.size2() == state.size2());
 		
-		SHARK_CRITICAL_REGION{
-			for(std::size_t i = 0; i != state.size1();++i){
-				for(std::size_t j = 0; j != state.size2();++j){
-					Normal<Rng> normal(rng,statistics(i,j),1.0);
-					state(i,j) = normal();
-				}
+		Normal<Rng> normal(rng,0.0,1.0);
+		for(std::size_t i = 0; i != state.size1();++i){
+			for(std::size_t j = 0; j != state.size2();++j){
+				state(i,j) = statistics(i,j) + normal();
 			}
 		}
 		(void) alpha;
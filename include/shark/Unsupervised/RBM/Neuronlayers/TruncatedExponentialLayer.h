@@ -37,7 +37,6 @@
 #include <shark/Unsupervised/RBM/StateSpaces/RealSpace.h>
 #include <shark/Unsupervised/RBM/Tags.h>
 #include <shark/Rng/TruncatedExponential.h>
-#include <shark/Core/OpenMP.h>
 namespace shark{
 namespace detail{
 template<class VectorType>
@@ -132,6 +131,9 @@ public:
 	/// In the case of alpha=1, flip-the-state sampling is performed, which takes the last state into account and tries to do deterministically jump 
 	/// into states with higher probability. THIS IS NOT IMPLEMENTED YET and alpha is ignored!
 	///
+	/// The function does not lock the random number generator. When sampling from several threads,
+	/// every thread must use its own generator.
+	///
 	/// @param statistics sufficient statistics for the batch to be computed
 	/// @param state the state matrix that will hold the sampled states
 	/// @param alpha factor changing from gibbs to flip-the state sampling. 0<=alpha<=1
@@ -142,13 +144,11 @@ public:
 		SIZE_CHECK(statistics.lambda.size1() == state.size1());
 		SIZE_CHECK(statistics.lambda.size2() == state.size2());
 		
-		SHARK_CRITICAL_REGION{
-			for(std::size_t i = 0; i != state.size1();++i){
-				for(std::size_t j = 0; j != state.size2();++j){
-					double integral = 1.0 - statistics.expMinusLambda(i,j);
-					TruncatedExponential<Rng> truncExp(integral,rng,statistics.lambda(i,j));
-					state(i,j) = truncExp();
-				}
+		for(std::size_t i = 0; i != state.size1();++i){
+			for(std::size_t j = 0; j != state.size2();++j){
+				double integral = 1.0 - statistics.expMinusLambda(i,j);
+				TruncatedExponential<Rng> truncExp(integral,rng,statistics.lambda(i,j));
+				state(i,j) = truncExp();
 			}
 		}
 		(void)alpha;//TODO: USE ALPHA
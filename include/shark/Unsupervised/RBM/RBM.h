@@ -31,6 +31,7 @@
 #define SHARK_UNSUPERVISED_RBM_RBM_H
 
 #include <shark/Models/AbstractModel.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Unsupervised/RBM/Energy.h>
 #include <shark/Unsupervised/RBM/Impl/AverageEnergyGradient.h>
 
@@ -84,7 +85,9 @@ private:
 			noalias(output) = hiddenNeurons().mean(statisticsBatch);
 		}
 		else{
-			hiddenNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			SHARK_CRITICAL_REGION{
+				hiddenNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			}
 		}
 	}
 
@@ -105,7 +108,9 @@ private:
 			noalias(output) = visibleNeurons().mean(statisticsBatch);
 		}
 		else{
-			visibleNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			SHARK_CRITICAL_REGION{
+				visibleNeurons().sample(statisticsBatch,output,0.0,*mpe_rng);
+			}
 		}
 	}
 public:
@@ -0,0 +1,310 @@
+/*!
+ *
+ *
+ * \brief       -
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_UNSUPERVISED_RBM_SAMPLING_BATCHEDTEMPEREDMARKOVCHAIN_H
+#define SHARK_UNSUPERVISED_RBM_SAMPLING_BATCHEDTEMPEREDMARKOVCHAIN_H
+
+#include <shark/Data/Dataset.h>
+#include <shark/Rng/DiscreteUniform.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Unsupervised/RBM/Tags.h>
+#include <boost/random/uniform_01.hpp>
+#include <vector>
+#include "Impl/SampleTypes.h"
+namespace shark{
+
+///\brief Models a batch of independent parallel tempering chains given a TransitionOperator.
+///
+///In contrast to the TemperedMarkovChain, which simulates the set of temperatures of a single chain,
+///this class runs several chains at once, each with its own set of temperatures.
+///The states of all chains at all temperatures are stored in a single batch, so that every Gibbs step
+///of all (chain x temperature) states is carried out as one batched matrix operation.
+///The i-th temperature of the c-th chain is stored in row c*numberOfTemperatures()+i of samples().
+///
+///After each Gibbs step, swaps between neighbouring temperatures are proposed in an even and an odd phase.
+///All proposals of a phase are independent and are evaluated in parallel.
+///The acceptance rates of the swaps between every pair of neighbouring temperatures are recorded
+///and can be used to tune the temperatures, see swapRates().
+///
+///The chain does not use the random number generator of the RBM while sampling. Instead it owns a random number stream
+///which is seeded from the generator of the RBM when the chain is initialized. Thus no locking is required.
+template<class Operator>
+class BatchedTemperedMarkovChain{
+private:
+	typedef typename Operator::HiddenSample HiddenSample;
+	typedef typename Operator::VisibleSample VisibleSample;
+public:
+
+	///\brief The chain computes a batch of samples from independent chains.
+	static const bool computesBatch = true;
+
+	///\brief The type of the RBM the operator is working with.
+	typedef typename Operator::RBM RBM;
+
+	///\brief A batch of samples containing hidden and visible samples as well as the energies.
+	typedef typename Batch<detail::MarkovChainSample<HiddenSample,VisibleSample> >::type SampleBatch;
+
+	///\brief Mutable reference to an element of the batch.
+	typedef typename SampleBatch::reference reference;
+
+	///\brief Immutable reference to an element of the batch.
+	typedef typename SampleBatch::const_reference const_reference;
+
+private:
+	SampleBatch m_samples;
+	RealVector m_betas;
+	RealVector m_rowBetas;
+	Operator m_operator;
+	typename RBM::RngType m_rng;
+
+	RealVector m_swapProposals;
+	RealVector m_swapAcceptances;
+
+	void updateRowBetas(){
+		std::size_t chains = batchSize();
+		std::size_t temperatures = numberOfTemperatures();
+		m_rowBetas.resize(chains * temperatures);
+		for(std::size_t c = 0; c != chains; ++c){
+			noalias(subrange(m_rowBetas,c*temperatures,(c+1)*temperatures)) = m_betas;
+		}
+	}
+
+	///\brief Proposes swaps between temperatures t and t+1 of every chain for t = start, start+2,...
+	void swapPhase(std::size_t start){
+		std::size_t chains = batchSize();
+		std::size_t temperatures = numberOfTemperatures();
+		if(start + 1 >= temperatures) return;
+		std::size_t pairsPerChain = (temperatures - start) / 2;
+		std::size_t pairs = chains * pairsPerChain;
+
+		//the uniform variates are drawn beforehand so that the result does not depend on the schedule
+		boost::uniform_01<double> uni;
+		RealVector z(pairs);
+		for(std::size_t p = 0; p != pairs; ++p){
+			z(p) = uni(m_rng);
+		}
+
+		RealVector const& baseRate = m_operator.rbm()->visibleNeurons().baseRate();
+		std::vector<char> accepted(pairs,0);
+		SHARK_PARALLEL_FOR(int p = 0; p < (int)pairs; ++p){
+			std::size_t c = p / pairsPerChain;
+			std::size_t t = start + 2 * (p % pairsPerChain);
+			std::size_t low = c * temperatures + t;
+			std::size_t high = low + 1;
+
+			double betaDiff = m_betas(t) - m_betas(t+1);
+			double energyDiff = m_samples.energy(low) - m_samples.energy(high);
+			double baseRateDiff = inner_prod(row(m_samples.visible.state,low),baseRate) - inner_prod(row(m_samples.visible.state,high),baseRate);
+			double r = betaDiff * energyDiff + betaDiff * baseRateDiff;
+			if( r >= 0 || (z(p) > 0 && std::log(z(p)) < r) ){
+				reference lowRef(m_samples,low);
+				reference highRef(m_samples,high);
+				swap(lowRef,highRef);
+				accepted[p] = 1;
+			}
+		}
+		for(std::size_t p = 0; p != pairs; ++p){
+			std::size_t t = start + 2 * (p % pairsPerChain);
+			m_swapProposals(t) += 1;
+			m_swapAcceptances(t) += accepted[p];
+		}
+	}
+
+public:
+	BatchedTemperedMarkovChain(RBM* rbm):m_operator(rbm){
+		setNumberOfTemperatures(1);
+		setBatchSize(1);
+	}
+
+	const Operator& transitionOperator()const{
+		return m_operator;
+	}
+	Operator& transitionOperator(){
+		return m_operator;
+	}
+
+	/// \brief Sets the number of temperatures of every chain.
+	///
+	/// The temperatures are initialized to 1 and the chains need to be initialized afterwards.
+	/// @param temperatures number of temperatures
+	void setNumberOfTemperatures(std::size_t temperatures){
+		SHARK_CHECK(temperatures > 0, "[BatchedTemperedMarkovChain::setNumberOfTemperatures] at least one temperature is needed");
+		std::size_t chains = m_betas.empty()? 1 : batchSize();
+		m_betas = RealVector(temperatures,1.0);
+		m_swapProposals = RealVector(temperatures - 1,0.0);
+		m_swapAcceptances = RealVector(temperatures - 1,0.0);
+		std::size_t visibles = m_operator.rbm()->numberOfVN();
+		std::size_t hiddens = m_operator.rbm()->numberOfHN();
+		m_samples = SampleBatch(chains*temperatures,visibles,hiddens);
+		updateRowBetas();
+	}
+
+	/// \brief Sets the number of temperatures and initializes them in a uniform spacing
+	///
+	/// Temperatures are spaced equally between 0 and 1.
+	/// @param temperatures number of temperatures
+	void setUniformTemperatureSpacing(std::size_t temperatures){
+		setNumberOfTemperatures(temperatures);
+		for(std::size_t i = 0; i != temperatures; ++i){
+			double factor = temperatures > 1? temperatures - 1.0 : 1.0;
+			setBeta(i,1.0 - i/factor);
+		}
+	}
+
+	/// \brief Returns the number Of temperatures.
+	std::size_t numberOfTemperatures()const{
+		return m_betas.size();
+	}
+
+	/// \brief Sets the number of independent chains.
+	void setBatchSize(std::size_t batchSize){
+		std::size_t visibles = m_operator.rbm()->numberOfVN();
+		std::size_t hiddens = m_operator.rbm()->numberOfHN();
+		m_samples = SampleBatch(batchSize*numberOfTemperatures(),visibles,hiddens);
+		updateRowBetas();
+	}
+
+	/// \brief Returns the number of independent chains.
+	std::size_t batchSize()const{
+		return m_samples.size() / numberOfTemperatures();
+	}
+
+	void setBeta(std::size_t i, double beta){
+		SIZE_CHECK(i < m_betas.size());
+		m_betas(i) = beta;
+		updateRowBetas();
+	}
+
+	double beta(std::size_t i)const{
+		SIZE_CHECK(i < m_betas.size());
+		return m_betas(i);
+	}
+
+	RealVector const& beta()const{
+		return m_betas;
+	}
+
+	///\brief Returns the rate of accepted swaps between temperature i and i+1 since the last reset.
+	///
+	///A common heuristic is to choose the temperatures such that all rates are roughly equal.
+	RealVector swapRates()const{
+		RealVector rates(m_swapProposals.size(),0.0);
+		for(std::size_t i = 0; i != rates.size(); ++i){
+			if(m_swapProposals(i) > 0)
+				rates(i) = m_swapAcceptances(i) / m_swapProposals(i);
+		}
+		return rates;
+	}
+
+	///\brief Resets the statistics of the swap proposals.
+	void resetSwapStatistics(){
+		m_swapProposals.clear();
+		m_swapAcceptances.clear();
+	}
+
+	///\brief Returns the current state of the first chain for beta = 1.
+	const_reference sample()const{
+		return const_reference(m_samples,0);
+	}
+
+	///\brief Returns the current states of all chains at all temperatures.
+	SampleBatch const& samples()const{
+		return m_samples;
+	}
+
+	///\brief Returns the current states of all chains at all temperatures.
+	///
+	///The whole state of the chains can be exchanged by swapping the batch.
+	SampleBatch& samples(){
+		return m_samples;
+	}
+
+	///\brief Returns the current states of all chains at beta=1, i.e. the samples from the model distribution.
+	SampleBatch modelSamples()const{
+		std::size_t temperatures = numberOfTemperatures();
+		std::size_t chains = batchSize();
+		SampleBatch result(chains,m_operator.rbm()->numberOfVN(),m_operator.rbm()->numberOfHN());
+		for(std::size_t c = 0; c != chains; ++c){
+			get(result,c) = get(m_samples,c*temperatures);
+		}
+		return result;
+	}
+
+	///\brief Initializes all states of the chains using samples drawn uniformly from the set.
+	///
+	/// @param dataSet the data set
+	void initializeChain(Data<RealVector> const& dataSet){
+		DiscreteUniform<typename RBM::RngType> uni(m_operator.rbm()->rng(),0,dataSet.numberOfElements()-1);
+		std::size_t visibles = m_operator.rbm()->numberOfVN();
+		RealMatrix sampleData(m_samples.size(),visibles);
+
+		for(std::size_t i = 0; i != m_samples.size(); ++i){
+			noalias(row(sampleData,i)) = dataSet.element(uni());
+		}
+		initializeChain(sampleData);
+	}
+
+	/// \brief Initializes the states with data points from a batch of points.
+	///
+	/// The i-th row is used as visible state of the i-th element of samples().
+	/// @param sampleData the batch of visible states
+	void initializeChain(RealMatrix const& sampleData){
+		SIZE_CHECK(sampleData.size1() == m_samples.size());
+		m_rng.seed(m_operator.rbm()->rng()());
+		m_samples.visible.state = sampleData;
+		m_operator.precomputeHidden(m_samples.hidden,m_samples.visible,m_rowBetas);
+		m_operator.sampleHidden(m_samples.hidden,m_rng);
+		m_samples.energy = m_operator.calculateEnergy(m_samples.hidden,m_samples.visible);
+		resetSwapStatistics();
+	}
+
+	///\brief Runs all chains for k steps. Every step is a Gibbs step of all states followed by the swap proposals.
+	void step(unsigned int k){
+		for(std::size_t i = 0; i != k; ++i){
+			//one Gibbs step of all chains and temperatures as a single batch
+			m_operator.precomputeVisible(m_samples.hidden,m_samples.visible,m_rowBetas);
+			m_operator.sampleVisible(m_samples.visible,m_rng);
+			m_operator.precomputeHidden(m_samples.hidden,m_samples.visible,m_rowBetas);
+			m_operator.sampleHidden(m_samples.hidden,m_rng);
+
+			m_samples.energy = m_operator.calculateEnergy(m_samples.hidden,m_samples.visible);
+
+			swapPhase(0);//EVEN phase
+			swapPhase(1);//ODD phase
+
+			//the swapped states are now at a different temperature
+			m_operator.rbm()->hiddenNeurons().sufficientStatistics(
+				m_samples.hidden.input,m_samples.hidden.statistics, m_rowBetas
+			);
+		}
+	}
+};
+
+}
+#endif
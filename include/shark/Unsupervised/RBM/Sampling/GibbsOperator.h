@@ -31,6 +31,7 @@
 #define SHARK_UNSUPERVISED_RBM_SAMPLING_GIBBSOPERATOR_H
 
 #include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
 #include "Impl/SampleTypes.h"
 namespace shark{
 	
@@ -120,16 +121,40 @@ public:
 	}
 
 	///\brief Samples a new batch of states of the hidden units using their precomputed statistics.
+	///
+	///The random number generator of the RBM is shared between all threads and is therefore locked while sampling.
 	void sampleHidden(HiddenSampleBatch& sampleBatch)const{
+		SHARK_CRITICAL_REGION{
+			sampleHidden(sampleBatch, mpe_rbm->rng());
+		}
+	}
+	
+	///\brief Samples a new batch of states of the hidden units using their precomputed statistics and a given random number generator.
+	///
+	///No locking takes place, thus the generator must not be used concurrently by another thread.
+	template<class Rng>
+	void sampleHidden(HiddenSampleBatch& sampleBatch, Rng& rng)const{
 		//sample state of the hidden neurons, input and statistics was allready computed by precompute
-		mpe_rbm->hiddenNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaHidden, mpe_rbm->rng());
+		mpe_rbm->hiddenNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaHidden, rng);
 	}
 
 
 	///\brief Samples a new batch of states of the visible units using their precomputed statistics.
+	///
+	///The random number generator of the RBM is shared between all threads and is therefore locked while sampling.
 	void sampleVisible(VisibleSampleBatch& sampleBatch)const{
+		SHARK_CRITICAL_REGION{
+			sampleVisible(sampleBatch, mpe_rbm->rng());
+		}
+	}
+	
+	///\brief Samples a new batch of states of the visible units using their precomputed statistics and a given random number generator.
+	///
+	///No locking takes place, thus the generator must not be used concurrently by another thread.
+	template<class Rng>
+	void sampleVisible(VisibleSampleBatch& sampleBatch, Rng& rng)const{
 		//sample state of the visible neurons, input and statistics was allready computed by precompute
-		mpe_rbm->visibleNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaVisible, mpe_rbm->rng());
+		mpe_rbm->visibleNeurons().sample(sampleBatch.statistics, sampleBatch.state, m_alphaVisible, rng);
 	}
 	
 	/// \brief Applies the Gibbs operator a number of times to a given sample.
@@ -123,6 +123,11 @@ public:
 		return m_samples;
 	}
 	
+	/// \brief Returns the samples of the model distribution, that is the current batch of samples of the Markov chain.
+	SampleBatch const& modelSamples()const{
+		return m_samples;
+	}
+	
 	/// \brief Returns the transition operator of the Markov chain.
 	Operator const& transitionOperator()const{
 		return m_operator;
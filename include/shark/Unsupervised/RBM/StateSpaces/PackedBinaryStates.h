@@ -0,0 +1,240 @@
+/*!
+ *
+ *
+ * \brief       Bit-packed storage of binary neuron states.
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_UNSUPERVISED_RBM_STATESPACES_PACKEDBINARYSTATES_H
+#define SHARK_UNSUPERVISED_RBM_STATESPACES_PACKEDBINARYSTATES_H
+
+#include <shark/LinAlg/Base.h>
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace shark{
+namespace detail{
+///\brief Number of set bits in a word.
+inline std::size_t popcount(boost::uint64_t word){
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(word);
+#else
+	std::size_t count = 0;
+	for(; word; ++count){
+		word &= word - 1;
+	}
+	return count;
+#endif
+}
+
+///\brief Index of the lowest set bit of a nonzero word.
+inline std::size_t lowestBit(boost::uint64_t word){
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(word);
+#else
+	std::size_t index = 0;
+	for(; !(word & 1); word >>= 1){
+		++index;
+	}
+	return index;
+#endif
+}
+}
+
+///\brief Stores a batch of states of binary neurons with one bit per neuron.
+///
+///Every row of the matrix is a state vector in {0,1}^n and is stored in a sequence of 64 bit words.
+///Compared to a RealMatrix this reduces the memory needed to store a batch of states by a factor of 64
+///and allows to compute products with real valued matrices by only visiting the active neurons,
+///see packedProd.
+class PackedBinaryMatrix{
+public:
+	typedef boost::uint64_t word_type;
+	static const std::size_t bitsPerWord = 64;
+
+	PackedBinaryMatrix():m_size1(0),m_size2(0),m_wordsPerRow(0){}
+
+	///\brief Creates a matrix with all states set to 0.
+	PackedBinaryMatrix(std::size_t size1, std::size_t size2){
+		resize(size1,size2);
+	}
+
+	///\brief Creates the packed representation of a matrix of binary states. Entries > 0 are interpreted as 1.
+	template<class Matrix>
+	explicit PackedBinaryMatrix(blas::matrix_expression<Matrix, blas::cpu_tag> const& states){
+		pack(states);
+	}
+
+	///\brief Number of states stored.
+	std::size_t size1()const{
+		return m_size1;
+	}
+	///\brief Number of neurons per state.
+	std::size_t size2()const{
+		return m_size2;
+	}
+	///\brief Number of words used to store a single state.
+	std::size_t wordsPerRow()const{
+		return m_wordsPerRow;
+	}
+
+	///\brief Resizes the matrix and sets all states to 0.
+	void resize(std::size_t size1, std::size_t size2){
+		m_size1 = size1;
+		m_size2 = size2;
+		m_wordsPerRow = (size2 + bitsPerWord - 1) / bitsPerWord;
+		m_bits.assign(m_size1 * m_wordsPerRow, 0);
+	}
+
+	bool operator()(std::size_t i, std::size_t j)const{
+		SIZE_CHECK(i < size1());
+		SIZE_CHECK(j < size2());
+		return (row(i)[j / bitsPerWord] >> (j % bitsPerWord)) & 1;
+	}
+
+	void set(std::size_t i, std::size_t j, bool value){
+		SIZE_CHECK(i < size1());
+		SIZE_CHECK(j < size2());
+		word_type mask = word_type(1) << (j % bitsPerWord);
+		word_type& word = row(i)[j / bitsPerWord];
+		word = value? (word | mask) : (word & ~mask);
+	}
+
+	///\brief Returns the words storing the i-th state. Unused trailing bits are always 0.
+	word_type const* row(std::size_t i)const{
+		return m_bits.empty()? 0: &m_bits[i * m_wordsPerRow];
+	}
+	word_type* row(std::size_t i){
+		return m_bits.empty()? 0: &m_bits[i * m_wordsPerRow];
+	}
+
+	///\brief Returns the number of active neurons in the i-th state.
+	std::size_t count(std::size_t i)const{
+		std::size_t result = 0;
+		word_type const* words = row(i);
+		for(std::size_t w = 0; w != m_wordsPerRow; ++w){
+			result += detail::popcount(words[w]);
+		}
+		return result;
+	}
+
+	///\brief Stores a matrix of binary states. Entries > 0 are interpreted as 1.
+	template<class Matrix>
+	void pack(blas::matrix_expression<Matrix, blas::cpu_tag> const& states){
+		resize(states().size1(),states().size2());
+		for(std::size_t i = 0; i != m_size1; ++i){
+			word_type* words = row(i);
+			for(std::size_t j = 0; j != m_size2; ++j){
+				words[j / bitsPerWord] |= word_type(states()(i,j) > 0) << (j % bitsPerWord);
+			}
+		}
+	}
+
+	///\brief Writes the states into a real valued matrix with entries in {0,1}.
+	template<class Matrix>
+	void unpack(blas::matrix_expression<Matrix, blas::cpu_tag>& states)const{
+		SIZE_CHECK(states().size1() == size1());
+		SIZE_CHECK(states().size2() == size2());
+		for(std::size_t i = 0; i != m_size1; ++i){
+			word_type const* words = row(i);
+			for(std::size_t j = 0; j != m_size2; ++j){
+				states()(i,j) = double((words[j / bitsPerWord] >> (j % bitsPerWord)) & 1);
+			}
+		}
+	}
+
+	friend void swap(PackedBinaryMatrix& a, PackedBinaryMatrix& b){
+		using std::swap;
+		swap(a.m_bits,b.m_bits);
+		swap(a.m_size1,b.m_size1);
+		swap(a.m_size2,b.m_size2);
+		swap(a.m_wordsPerRow,b.m_wordsPerRow);
+	}
+private:
+	std::vector<word_type> m_bits;
+	std::size_t m_size1;
+	std::size_t m_size2;
+	std::size_t m_wordsPerRow;
+};
+
+///\brief Computes result = states * weights for a batch of packed binary states.
+///
+///The i-th row of the result is the sum of the rows of weights belonging to the active neurons of the i-th state.
+///Thus the cost is proportional to the number of active neurons instead of the number of neurons.
+///For an RBM with binary hidden units, the input of the visible units is packedProd(h, W, result) and
+///the input of the hidden units given binary visible units is packedProd(v, trans(W), result). For the latter
+///case a row-major copy of trans(W) should be used as the rows are visited one at a time.
+template<class WeightMatrix, class ResultMatrix>
+void packedProd(
+	PackedBinaryMatrix const& states,
+	blas::matrix_expression<WeightMatrix, blas::cpu_tag> const& weights,
+	blas::matrix_expression<ResultMatrix, blas::cpu_tag>& result
+){
+	SIZE_CHECK(states.size2() == weights().size1());
+	SIZE_CHECK(states.size1() == result().size1());
+	SIZE_CHECK(weights().size2() == result().size2());
+	typedef PackedBinaryMatrix::word_type word_type;
+
+	result().clear();
+	for(std::size_t i = 0; i != states.size1(); ++i){
+		word_type const* words = states.row(i);
+		for(std::size_t w = 0; w != states.wordsPerRow(); ++w){
+			for(word_type bits = words[w]; bits; bits &= bits - 1){
+				std::size_t k = w * PackedBinaryMatrix::bitsPerWord + detail::lowestBit(bits);
+				noalias(row(result(),i)) += row(weights(),k);
+			}
+		}
+	}
+}
+
+///\brief Computes the matrix of inner products between two batches of binary states using bitwise and + popcount.
+///
+///This computes result = prod(states1,trans(states2)) for binary states, e.g. the number of common active hidden units.
+template<class ResultMatrix>
+void packedInnerProducts(
+	PackedBinaryMatrix const& states1,
+	PackedBinaryMatrix const& states2,
+	blas::matrix_expression<ResultMatrix, blas::cpu_tag>& result
+){
+	SIZE_CHECK(states1.size2() == states2.size2());
+	SIZE_CHECK(states1.size1() == result().size1());
+	SIZE_CHECK(states2.size1() == result().size2());
+	typedef PackedBinaryMatrix::word_type word_type;
+
+	for(std::size_t i = 0; i != states1.size1(); ++i){
+		word_type const* words1 = states1.row(i);
+		for(std::size_t j = 0; j != states2.size1(); ++j){
+			word_type const* words2 = states2.row(j);
+			std::size_t count = 0;
+			for(std::size_t w = 0; w != states1.wordsPerRow(); ++w){
+				count += detail::popcount(words1[w] & words2[w]);
+			}
+			result()(i,j) = double(count);
+		}
+	}
+}
+
+}
+#endif
@@ -203,5 +203,96 @@ double annealedImportanceSampling(
 	return annealedImportanceSampling(rbm,beta,samples);
 }
 
+///\brief Linearly spaced inverse temperatures from 1 down to 0.
+///
+///@param temperatures the number of temperatures, at least 2
+inline RealVector linearBetaSchedule(std::size_t temperatures){
+	SHARK_CHECK(temperatures > 1, "[linearBetaSchedule] at least two temperatures are needed");
+	RealVector beta(temperatures);
+	for(std::size_t i = 0; i != temperatures; ++i){
+		beta(i) = 1.0-i/double(temperatures-1);
+	}
+	return beta;
+}
+
+///\brief Geometrically spaced inverse temperatures from 1 down to betaMin, followed by 0.
+///
+///Compared to a linear schedule, more temperatures are placed close to 0. This is useful when the
+///distribution changes quickly at small beta, which is the case for RBMs with large weights.
+///
+///@param temperatures the number of temperatures including 0, at least 3
+///@param betaMin the smallest nonzero inverse temperature, 0 < betaMin < 1
+inline RealVector geometricBetaSchedule(std::size_t temperatures, double betaMin){
+	SHARK_CHECK(temperatures > 2, "[geometricBetaSchedule] at least three temperatures are needed");
+	SHARK_CHECK(betaMin > 0 && betaMin < 1, "[geometricBetaSchedule] betaMin must be in (0,1)");
+	RealVector beta(temperatures);
+	for(std::size_t i = 0; i != temperatures-1; ++i){
+		beta(i) = std::pow(betaMin, i/double(temperatures-2));
+	}
+	beta(temperatures-1) = 0.0;
+	return beta;
+}
+
+///\brief Result of an estimation of the log partition function.
+struct LogPartitionEstimate{
+	///\brief The estimate of the log partition function.
+	double logPartition;
+	///\brief Estimated standard deviation of logPartition.
+	double standardError;
+	///\brief log(Z - 3 sigma_Z), lower end of the confidence interval. -infinity if Z - 3 sigma_Z <= 0.
+	double logLowerBound;
+	///\brief log(Z + 3 sigma_Z), upper end of the confidence interval.
+	double logUpperBound;
+	///\brief Effective number of runs (sum w)^2/sum(w^2). Values much smaller than the number of runs indicate an unreliable estimate.
+	double effectiveSampleSize;
+	///\brief The log importance weight of every run.
+	RealVector logWeights;
+};
+
+///\brief Estimates the log partition function using annealed importance sampling (AIS).
+///
+///Starting from exact samples of the RBM at inverse temperature 0, the partition function of which is known in closed form,
+///the runs move through the sequence of inverse temperatures beta to beta=1. All runs are independent.
+///They are simulated in batches, where every batch is one matrix operation per Gibbs step and
+///the batches are sampled in parallel using one random number generator per batch.
+///
+///Aside from the estimate, the variance of the importance weights is used to compute an approximate standard error
+///and a confidence interval of 3 standard deviations of the estimate of Z. Note that AIS tends to underestimate
+///the partition function when the schedule is too short, which is not reflected in the confidence interval.
+///
+///@param rbm the RBM for which to estimate the partition function. Its random number generator is used to seed the batches.
+///@param beta the sequence of inverse temperatures. It must start with 1 and end with 0, see linearBetaSchedule and geometricBetaSchedule.
+///@param runs the number of independent annealing runs
+///@param batchSize the number of runs which are simulated at once
+template<class RBMType>
+LogPartitionEstimate estimateLogPartitionFunction(
+	RBMType& rbm, RealVector const& beta, std::size_t runs, std::size_t batchSize = 100
+){
+	SHARK_CHECK(beta.size() > 1, "[estimateLogPartitionFunction] at least two temperatures are needed");
+	SHARK_CHECK(beta(0) == 1.0, "[estimateLogPartitionFunction] the first inverse temperature must be 1");
+	SHARK_CHECK(beta(beta.size()-1) == 0.0, "[estimateLogPartitionFunction] the last inverse temperature must be 0");
+	SHARK_CHECK(runs > 0, "[estimateLogPartitionFunction] at least one run is needed");
+	SHARK_CHECK(batchSize > 0, "[estimateLogPartitionFunction] batch size must be positive");
+	
+	LogPartitionEstimate estimate;
+	estimate.logWeights.resize(runs);
+	detail::annealedImportanceWeights(rbm,beta,estimate.logWeights,batchSize);
+	
+	//normalize the weights by the largest weight before exponentiating
+	double maxLogWeight = max(estimate.logWeights);
+	RealVector weights = exp(estimate.logWeights - maxLogWeight);
+	double meanWeight = sum(weights)/runs;
+	double variance = runs > 1? sum(sqr(weights - meanWeight))/(runs-1) : 0.0;
+	double sigma = std::sqrt(variance/runs);//standard deviation of the mean
+	
+	double logBase = logPartitionFunction(rbm,0.0) + maxLogWeight;
+	estimate.logPartition = logBase + std::log(meanWeight);
+	estimate.standardError = sigma/meanWeight;
+	estimate.logUpperBound = logBase + std::log(meanWeight + 3*sigma);
+	estimate.logLowerBound = meanWeight > 3*sigma ? logBase + std::log(meanWeight - 3*sigma): -std::numeric_limits<double>::infinity();
+	estimate.effectiveSampleSize = sqr(sum(weights))/sum(sqr(weights));
+	return estimate;
+}
+
 }
 #endif
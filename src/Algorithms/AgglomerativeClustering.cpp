@@ -0,0 +1,316 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Agglomerative hierarchical clustering.
+ * 
+ * 
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2016 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#define SHARK_COMPILE_DLL
+#include <shark/Algorithms/AgglomerativeClustering.h>
+#include <shark/Core/OpenMP.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+using namespace shark;
+
+namespace{
+///\brief A merge of the clusters represented by two points, before the clusters are labeled.
+struct RawMerge{
+	RawMerge(std::size_t a, std::size_t b, double d):first(a), second(b), distance(d){}
+	std::size_t first;
+	std::size_t second;
+	double distance;
+	bool operator<(RawMerge const& other)const{
+		return distance < other.distance;
+	}
+};
+
+///\brief Union-find structure to label the clusters.
+class ClusterLabels{
+public:
+	ClusterLabels(std::size_t n):m_parent(n), m_label(n), m_size(n,1){
+		for(std::size_t i = 0; i != n; ++i){
+			m_parent[i] = i;
+			m_label[i] = i;
+		}
+	}
+	std::size_t find(std::size_t i){
+		while(m_parent[i] != i){
+			m_parent[i] = m_parent[m_parent[i]];
+			i = m_parent[i];
+		}
+		return i;
+	}
+	///\brief Merges the sets with roots a and b and gives the result a new label.
+	void merge(std::size_t a, std::size_t b, std::size_t label){
+		if(m_size[a] < m_size[b]) std::swap(a,b);
+		m_parent[b] = a;
+		m_size[a] += m_size[b];
+		m_label[a] = label;
+	}
+	std::size_t label(std::size_t root)const{
+		return m_label[root];
+	}
+	std::size_t size(std::size_t root)const{
+		return m_size[root];
+	}
+private:
+	std::vector<std::size_t> m_parent;
+	std::vector<std::size_t> m_label;
+	std::vector<std::size_t> m_size;
+};
+
+///\brief Sorts the merges by distance and labels the clusters.
+///
+///The merges must be stored in the order they were performed, so that
+///merges with equal distance keep their order.
+std::vector<ClusterMerge> labelMerges(std::vector<RawMerge>& raw, std::size_t n){
+	std::stable_sort(raw.begin(),raw.end());
+	ClusterLabels labels(n);
+	std::vector<ClusterMerge> merges(raw.size());
+	for(std::size_t i = 0; i != raw.size(); ++i){
+		std::size_t a = labels.find(raw[i].first);
+		std::size_t b = labels.find(raw[i].second);
+		merges[i].left = std::min(labels.label(a),labels.label(b));
+		merges[i].right = std::max(labels.label(a),labels.label(b));
+		merges[i].distance = raw[i].distance;
+		merges[i].size = labels.size(a) + labels.size(b);
+		labels.merge(a,b,n+i);
+	}
+	return merges;
+}
+
+///\brief Computes the distances of point i to the points 0,...,end-1 in parallel.
+void distancesToPoint(RealMatrix const& points, std::size_t i, std::size_t end, RealVector& distances){
+	std::size_t blockSize = 256;
+	std::size_t numBlocks = (end + blockSize - 1) / blockSize;
+	SHARK_PARALLEL_FOR(int block = 0; block < (int)numBlocks; ++block){
+		std::size_t start = block * blockSize;
+		std::size_t stop = std::min(start + blockSize, end);
+		for(std::size_t j = start; j != stop; ++j){
+			distances(j) = norm_2(row(points,j) - row(points,i));
+		}
+	}
+}
+
+///\brief SLINK: single linkage in pointer representation.
+///
+///After processing point i, pi(j) is the point with the largest index j is merged with,
+///at distance lambda(j).
+std::vector<RawMerge> singleLinkage(RealMatrix const& points){
+	std::size_t n = points.size1();
+	double inf = std::numeric_limits<double>::infinity();
+	std::vector<std::size_t> pi(n);
+	RealVector lambda(n);
+	RealVector m(n);
+	for(std::size_t i = 0; i != n; ++i){
+		pi[i] = i;
+		lambda(i) = inf;
+		distancesToPoint(points, i, i, m);
+		for(std::size_t j = 0; j != i; ++j){
+			if(lambda(j) >= m(j)){
+				m(pi[j]) = std::min(m(pi[j]), lambda(j));
+				lambda(j) = m(j);
+				pi[j] = i;
+			}else{
+				m(pi[j]) = std::min(m(pi[j]), m(j));
+			}
+		}
+		for(std::size_t j = 0; j != i; ++j){
+			if(lambda(j) >= lambda(pi[j]))
+				pi[j] = i;
+		}
+	}
+	std::vector<RawMerge> raw;
+	raw.reserve(n - 1);
+	for(std::size_t j = 0; j != n; ++j){
+		if(pi[j] != j)
+			raw.push_back(RawMerge(j, pi[j], lambda(j)));
+	}
+	return raw;
+}
+
+///\brief Set of active clusters with constant time removal.
+class ActiveSet{
+public:
+	ActiveSet(std::size_t n):m_elements(n), m_position(n){
+		for(std::size_t i = 0; i != n; ++i){
+			m_elements[i] = i;
+			m_position[i] = i;
+		}
+	}
+	std::size_t size()const{
+		return m_elements.size();
+	}
+	std::size_t operator[](std::size_t i)const{
+		return m_elements[i];
+	}
+	void remove(std::size_t element){
+		std::size_t pos = m_position[element];
+		m_elements[pos] = m_elements.back();
+		m_position[m_elements[pos]] = pos;
+		m_elements.pop_back();
+	}
+private:
+	std::vector<std::size_t> m_elements;
+	std::vector<std::size_t> m_position;
+};
+
+///\brief Nearest-neighbor chain algorithm.
+///
+///The Linkage object provides the distances between the clusters represented by two points
+///and merges two clusters. The merged cluster is represented by the first point.
+template<class Linkage>
+std::vector<RawMerge> nearestNeighborChain(Linkage& linkage, std::size_t n){
+	ActiveSet active(n);
+	std::vector<std::size_t> chain;
+	std::vector<RawMerge> raw;
+	raw.reserve(n - 1);
+	RealVector distances(n);
+	while(active.size() > 1){
+		if(chain.empty())
+			chain.push_back(active[0]);
+		std::size_t a = chain.back();
+		//find the nearest neighbor of a. On ties, the previous element of the chain
+		//is preferred, this guarantees that the chain ends in a pair of reciprocal nearest neighbors
+		linkage.distances(a, active, distances);
+		std::size_t best = chain.size() > 1? chain[chain.size() - 2] : n;
+		double bestDistance = best != n? distances(best) : std::numeric_limits<double>::infinity();
+		for(std::size_t i = 0; i != active.size(); ++i){
+			std::size_t c = active[i];
+			if(c != a && distances(c) < bestDistance){
+				bestDistance = distances(c);
+				best = c;
+			}
+		}
+		if(chain.size() > 1 && best == chain[chain.size() - 2]){
+			chain.pop_back();
+			chain.pop_back();
+			std::size_t first = std::min(a,best);
+			std::size_t second = std::max(a,best);
+			raw.push_back(RawMerge(first, second, bestDistance));
+			active.remove(second);
+			linkage.merge(first, second, active);
+		}else{
+			chain.push_back(best);
+		}
+	}
+	return raw;
+}
+
+///\brief Ward linkage computed from the cluster centroids.
+class WardDistances{
+public:
+	WardDistances(RealMatrix const& points):m_centroids(points), m_sizes(points.size1(),1.0){}
+
+	void distances(std::size_t a, ActiveSet const& active, RealVector& distances)const{
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)active.size(); ++i){
+			std::size_t c = active[i];
+			double factor = 2 * m_sizes(a) * m_sizes(c) / (m_sizes(a) + m_sizes(c));
+			distances(c) = std::sqrt(factor * distanceSqr(row(m_centroids,a),row(m_centroids,c)));
+		}
+	}
+
+	void merge(std::size_t a, std::size_t b, ActiveSet const&){
+		double size = m_sizes(a) + m_sizes(b);
+		noalias(row(m_centroids,a)) = (m_sizes(a) * row(m_centroids,a) + m_sizes(b) * row(m_centroids,b)) / size;
+		m_sizes(a) = size;
+	}
+private:
+	RealMatrix m_centroids;
+	RealVector m_sizes;
+};
+
+///\brief Complete and average linkage, using the matrix of pairwise distances with Lance-Williams updates.
+class MatrixDistances{
+public:
+	MatrixDistances(RealMatrix const& points, AgglomerativeLinkage linkage)
+	:m_n(points.size1()), m_distances(m_n * (m_n - 1) / 2), m_sizes(m_n,1.0), m_linkage(linkage){
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_n; ++i){
+			for(std::size_t j = i + 1; j < m_n; ++j){
+				m_distances[index(i,j)] = norm_2(row(points,i) - row(points,j));
+			}
+		}
+	}
+
+	void distances(std::size_t a, ActiveSet const& active, RealVector& distances)const{
+		for(std::size_t i = 0; i != active.size(); ++i){
+			std::size_t c = active[i];
+			if(c != a)
+				distances(c) = m_distances[index(a,c)];
+		}
+	}
+
+	void merge(std::size_t a, std::size_t b, ActiveSet const& active){
+		double sizeA = m_sizes(a);
+		double sizeB = m_sizes(b);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)active.size(); ++i){
+			std::size_t c = active[i];
+			if(c == a) continue;
+			double& dA = m_distances[index(a,c)];
+			double dB = m_distances[index(b,c)];
+			if(m_linkage == CompleteLinkage)
+				dA = std::max(dA,dB);
+			else
+				dA = (sizeA * dA + sizeB * dB) / (sizeA + sizeB);
+		}
+		m_sizes(a) = sizeA + sizeB;
+	}
+private:
+	std::size_t index(std::size_t i, std::size_t j)const{
+		if(i > j) std::swap(i,j);
+		return i * m_n - i * (i + 1) / 2 + j - i - 1;
+	}
+	std::size_t m_n;
+	std::vector<double> m_distances;
+	RealVector m_sizes;
+	AgglomerativeLinkage m_linkage;
+};
+}
+
+std::vector<ClusterMerge> shark::agglomerativeClustering(Data<RealVector> const& data, AgglomerativeLinkage linkage){
+	std::size_t n = data.numberOfElements();
+	if(n < 2)
+		return std::vector<ClusterMerge>();
+	RealMatrix points = createBatch<RealVector>(data.elements());
+
+	std::vector<RawMerge> raw;
+	if(linkage == SingleLinkage){
+		raw = singleLinkage(points);
+	}else if(linkage == WardLinkage){
+		WardDistances distances(points);
+		raw = nearestNeighborChain(distances, n);
+	}else{
+		MatrixDistances distances(points, linkage);
+		raw = nearestNeighborChain(distances, n);
+	}
+	return labelMerges(raw, n);
+}
@@ -35,6 +35,7 @@
 #include <shark/Algorithms/Trainers/FisherLDA.h>
 #include <shark/LinAlg/eigenvalues.h>
 #include <shark/LinAlg/solveSystem.h>
+#include <shark/Data/Statistics.h>
 using namespace shark;
 
 
@@ -80,54 +81,43 @@ void FisherLDA::meanAndScatter(
 	std::size_t classes = numberOfClasses(dataset);
 	std::size_t inputs = dataset.numberOfElements();
 	std::size_t inputDim = inputDimension(dataset);
-	
 
-	// intermediate results
-	std::vector<RealVector> means(classes, RealVector(inputDim,0.0));
-	std::vector<RealMatrix> covariances(classes, RealMatrix(inputDim, inputDim,0.0));
+	// calculate mean and number of examples of every class.
+	RealMatrix means(classes, inputDim, 0.0);
 	std::vector<std::size_t> counter(classes, 0);   // counter for examples per class
-
-	// calculate mean and scatter for every class.
-
-	// for every example in set ...
-	for(auto point: dataset.elements()){
-		//find class
-		std::size_t c= point.label;
-
-		// count example
-		counter[c] += 1;
-
-		// add example to mean vector
-		noalias(means[c])+=point.input;
-		// add example to scatter matrix
-		noalias(covariances[c]) += outer_prod( point.input, point.input );
+	for(auto const& batch: dataset.batches()){
+		for(std::size_t e = 0; e != batch.input.size1(); ++e){
+			std::size_t c = batch.label(e);
+			counter[c] += 1;
+			noalias(row(means,c)) += row(batch.input,e);
+		}
 	}
-
-	// for every class ...
 	for( std::size_t c = 0; c != classes ; c++ ) {
-		// normalize mean vector
-		means[c] /= counter[c];
-
-		// make scatter mean free
-		noalias(covariances[c]) -= outer_prod(counter[c]*means[c],means[c]);
+		row(means,c) /= counter[c];
 	}
 
-	// calculate global mean and final scatter
-
-	RealMatrix Sb( inputDim, inputDim,0.0 ); // between-class scatter
-	RealMatrix Sw( inputDim, inputDim,0.0 ); // within-class scatter
+	// within-class scatter: the scatter matrix of the points
+	// after subtracting the mean of their class
+	typedef LabeledData<RealVector, unsigned int>::const_batch_reference BatchRef;
+	RealMatrix Sw;
+	scatterMatrix(dataset,[&](BatchRef batch) -> RealMatrix{
+		RealMatrix centered = batch.input;
+		for(std::size_t e = 0; e != centered.size1(); ++e){
+			noalias(row(centered,e)) -= row(means,batch.label(e));
+		}
+		return centered;
+	},Sw);
 
-	// calculate global mean
+	// calculate global mean and between-class scatter
+	mean.resize(inputDim);
 	mean.clear();
 	for (std::size_t c = 0; c != classes; c++) 
-		noalias(mean) += counter[c] * means[c]/inputs;
-	mean /= inputs;
+		noalias(mean) += double(counter[c]) / inputs * row(means,c);
 
-	// calculate between- and within-class scatters
+	RealMatrix Sb( inputDim, inputDim,0.0 ); // between-class scatter
 	for (std::size_t c = 0; c != classes; c++) {
-		RealVector diff = means[c] - mean;
+		RealVector diff = row(means,c) - mean;
 		noalias(Sb) += outer_prod(counter[c] * diff,diff);
-		noalias(Sw) += covariances[c];
 	}
 
 	// invert Sw
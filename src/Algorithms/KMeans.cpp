@@ -34,13 +34,186 @@
 
 #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/KMeans.h>
-#include <shark/Models/Clustering/HardClusteringModel.h>
 #include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
 
-#include <boost/range/algorithm/equal.hpp>
 #include <limits>
+#include <algorithm>
 using namespace shark;
 
+namespace{
+///\brief Stores the rows of a matrix as centroids.
+void setCenters(Centroids& centroids, RealMatrix const& centers){
+	Data<RealVector> data(1);
+	data.batch(0) = centers;
+	centroids.setCentroids(data);
+}
+
+///\brief Offsets of the first elements of all batches of a dataset.
+std::vector<std::size_t> batchOffsets(Data<RealVector> const& dataset){
+	std::vector<std::size_t> offsets(dataset.numberOfBatches() + 1,0);
+	for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+		offsets[b + 1] = offsets[b] + dataset.batch(b).size1();
+	}
+	return offsets;
+}
+
+///\brief Updates the squared distances of all points to their closest center with a set of new centers.
+///
+///The distances are computed batch-wise as matrix products.
+void updateMinDistances(
+	Data<RealVector> const& dataset, std::vector<std::size_t> const& offsets,
+	RealMatrix const& newCenters, RealVector& minDistances
+){
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)dataset.numberOfBatches(); ++b){
+		RealMatrix distances = distanceSqr(dataset.batch(b),newCenters);
+		for(std::size_t i = 0; i != distances.size1(); ++i){
+			double& minDistance = minDistances(offsets[b] + i);
+			minDistance = std::min(minDistance, std::max(0.0,min(row(distances,i))));
+		}
+	}
+}
+
+///\brief Draws an index with probability proportional to its weight.
+std::size_t sampleIndex(RealVector const& weights){
+	double total = sum(weights);
+	if(!(total > 0))//all weights zero, draw uniformly
+		return Rng::discrete(0, weights.size() - 1);
+	double threshold = Rng::uni(0, total);
+	double cumulative = 0;
+	for(std::size_t i = 0; i != weights.size(); ++i){
+		cumulative += weights(i);
+		if(cumulative >= threshold && weights(i) > 0)
+			return i;
+	}
+	//rounding errors, return the last point with positive weight
+	std::size_t i = weights.size() - 1;
+	while(weights(i) == 0) --i;
+	return i;
+}
+
+///\brief k-means++ seeding on a small set of weighted points.
+RealMatrix weightedKMeansPlusPlus(RealMatrix const& points, RealVector const& weights, std::size_t k){
+	std::size_t n = points.size1();
+	RealMatrix centers(k, points.size2());
+	RealVector minDistances(n, std::numeric_limits<double>::max());
+	for(std::size_t c = 0; c != k; ++c){
+		std::size_t index = c == 0? sampleIndex(weights): sampleIndex(element_prod(weights,minDistances));
+		noalias(row(centers,c)) = row(points,index);
+		RealVector distances = distanceSqr(points,row(centers,c));
+		for(std::size_t i = 0; i != n; ++i){
+			minDistances(i) = std::min(minDistances(i), distances(i));
+		}
+	}
+	return centers;
+}
+
+///\brief Finds the closest and second closest center of every row of a matrix of squared distances.
+void closestCenters(
+	RealMatrix const& distances, std::size_t i,
+	std::size_t& best, double& bestDistance, double& secondDistance
+){
+	best = 0;
+	bestDistance = std::numeric_limits<double>::max();
+	secondDistance = std::numeric_limits<double>::max();
+	for(std::size_t c = 0; c != distances.size2(); ++c){
+		double d = distances(i,c);
+		if(d < bestDistance){
+			secondDistance = bestDistance;
+			bestDistance = d;
+			best = c;
+		}else if(d < secondDistance){
+			secondDistance = d;
+		}
+	}
+	bestDistance = std::sqrt(std::max(0.0,bestDistance));
+	secondDistance = std::sqrt(std::max(0.0,secondDistance));
+}
+}
+
+void shark::initKMeansPlusPlus(Data<RealVector> const& dataset, std::size_t k, Centroids& centroids){
+	std::size_t ell = dataset.numberOfElements();
+	SIZE_CHECK(k <= ell);
+	DataView<Data<RealVector> const> points(dataset);
+	std::vector<std::size_t> offsets = batchOffsets(dataset);
+
+	RealMatrix centers(k, dataDimension(dataset));
+	RealVector minDistances(ell, std::numeric_limits<double>::max());
+	for(std::size_t c = 0; c != k; ++c){
+		std::size_t index = c == 0? Rng::discrete(0, ell - 1) : sampleIndex(minDistances);
+		noalias(row(centers,c)) = points[index];
+		RealMatrix newCenter = rows(centers,c,c+1);
+		updateMinDistances(dataset, offsets, newCenter, minDistances);
+	}
+	setCenters(centroids,centers);
+}
+
+void shark::initKMeansParallel(
+	Data<RealVector> const& dataset, std::size_t k, Centroids& centroids,
+	std::size_t rounds, double oversampling
+){
+	std::size_t ell = dataset.numberOfElements();
+	std::size_t dimension = dataDimension(dataset);
+	SIZE_CHECK(k <= ell);
+	if(oversampling <= 0)
+		oversampling = 2.0 * k;
+	DataView<Data<RealVector> const> points(dataset);
+	std::vector<std::size_t> offsets = batchOffsets(dataset);
+
+	//start with one random point
+	std::vector<std::size_t> candidates(1, Rng::discrete(0, ell - 1));
+	RealMatrix newCenters(1, dimension);
+	noalias(row(newCenters,0)) = points[candidates[0]];
+	RealVector minDistances(ell, std::numeric_limits<double>::max());
+	updateMinDistances(dataset, offsets, newCenters, minDistances);
+
+	//in every round, sample every point independently with probability proportional to its squared distance
+	for(std::size_t r = 0; r != rounds; ++r){
+		double total = sum(minDistances);
+		if(!(total > 0)) break;
+		std::vector<std::size_t> sampled;
+		for(std::size_t i = 0; i != ell; ++i){
+			if(Rng::uni(0,1) * total < oversampling * minDistances(i))
+				sampled.push_back(i);
+		}
+		if(sampled.empty()) continue;
+		newCenters.resize(sampled.size(), dimension);
+		for(std::size_t i = 0; i != sampled.size(); ++i){
+			noalias(row(newCenters,i)) = points[sampled[i]];
+		}
+		updateMinDistances(dataset, offsets, newCenters, minDistances);
+		candidates.insert(candidates.end(), sampled.begin(), sampled.end());
+	}
+	//not enough candidates, add further points
+	while(candidates.size() < k){
+		std::size_t index = sampleIndex(minDistances);
+		candidates.push_back(index);
+		newCenters.resize(1, dimension);
+		noalias(row(newCenters,0)) = points[index];
+		updateMinDistances(dataset, offsets, newCenters, minDistances);
+	}
+
+	RealMatrix candidateMatrix(candidates.size(), dimension);
+	for(std::size_t i = 0; i != candidates.size(); ++i){
+		noalias(row(candidateMatrix,i)) = points[candidates[i]];
+	}
+	//weight every candidate by the number of points closest to it
+	std::size_t numThreads = SHARK_NUM_THREADS;
+	std::vector<RealVector> threadWeights(numThreads, RealVector(candidates.size(), 0.0));
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)dataset.numberOfBatches(); ++b){
+		RealMatrix distances = distanceSqr(dataset.batch(b), candidateMatrix);
+		RealVector& weights = threadWeights[SHARK_THREAD_NUM];
+		for(std::size_t i = 0; i != distances.size1(); ++i){
+			weights(arg_min(row(distances,i))) += 1.0;
+		}
+	}
+	RealVector weights(candidates.size(), 0.0);
+	for(std::size_t t = 0; t != numThreads; ++t){
+		noalias(weights) += threadWeights[t];
+	}
+	//recluster the weighted candidates
+	setCenters(centroids, weightedKMeansPlusPlus(candidateMatrix, weights, k));
+}
 
 std::size_t shark::kMeans(Data<RealVector> const& dataset, std::size_t k, Centroids& centroids, std::size_t maxIterations){
 	SIZE_CHECK(k <= dataset.numberOfElements());
@@ -50,48 +223,128 @@ std::size_t shark::kMeans(Data<RealVector> const& dataset, std::size_t k, Centro
 	// initialization
 	std::size_t ell = dataset.numberOfElements();
 	std::size_t dimension = dataDimension(dataset);
+	std::size_t numBatches = dataset.numberOfBatches();
+	std::vector<std::size_t> offsets = batchOffsets(dataset);
 	
 	//if the centers are not already initialized, do it now
 	if (centroids.numberOfClusters() != k){
-		centroids.initFromData(dataset,k);
+		initKMeansParallel(dataset,k,centroids);
+	}
+	RealMatrix centers = createBatch<RealVector>(centroids.centroids().elements());
+
+	//Hamerly's algorithm: for every point we store the assigned cluster,
+	//an upper bound on the distance to its center and a lower bound on the distance to all other centers.
+	std::vector<std::size_t> assignment(ell);
+	RealVector upper(ell);
+	RealVector lower(ell);
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)numBatches; ++b){
+		RealMatrix distances = distanceSqr(dataset.batch(b),centers);
+		for(std::size_t i = 0; i != distances.size1(); ++i){
+			std::size_t p = offsets[b] + i;
+			closestCenters(distances, i, assignment[p], upper(p), lower(p));
+		}
+	}
+	//sums of the points of every cluster
+	RealMatrix sums(k, dimension, 0.0);
+	RealVector numPoints(k, 0.0);
+	for(std::size_t b = 0; b != numBatches; ++b){
+		RealMatrix const& batch = dataset.batch(b);
+		for(std::size_t i = 0; i != batch.size1(); ++i){
+			std::size_t c = assignment[offsets[b] + i];
+			noalias(row(sums,c)) += row(batch,i);
+			numPoints(c) += 1;
+		}
 	}
-	HardClusteringModel<RealVector> model(&centroids);
-	ClassificationDataset clusterMembership(dataset,model(dataset));
 
 	// k-means loop
 	std::size_t iter = 0;
 	bool equal = false;
+	std::vector<std::vector<std::size_t> > moved(numBatches);
+	std::vector<std::vector<std::size_t> > movedFrom(numBatches);
 	for(; iter != maxIterations && !equal; ++iter) {
-		// compute new centers
-		std::vector<std::size_t> numPoints(k,0); // number of points in each cluster
-		std::vector<RealVector> newCenters(k,RealVector(dimension,0.0));
-			
-		for(auto element: clusterMembership.elements()){
-			std::size_t j = element.label;
-			noalias(newCenters[j]) += element.input;
-			numPoints[j]++;
-		}
+		// compute new centers and how far they moved
+		RealMatrix newCenters(k, dimension);
+		RealVector movement(k);
 		for (std::size_t j=0; j<k; j++) {
-			if (numPoints[j] == 0) {
+			if (numPoints(j) == 0) {
 				// empty cluster - assign random training point
 				std::size_t index = Rng::discrete(0, ell-1);
-				newCenters[j] = dataset.element(index);
+				noalias(row(newCenters,j)) = dataset.element(index);
 			}
 			else {
-				newCenters[j] /= (double)numPoints[j];
+				noalias(row(newCenters,j)) = row(sums,j) / numPoints(j);
+			}
+			movement(j) = norm_2(row(newCenters,j) - row(centers,j));
+		}
+		centers = newCenters;
+		std::size_t farthest = arg_max(movement);
+		double maxMovement = movement(farthest);
+		movement(farthest) = 0;
+		double secondMovement = max(movement);
+		movement(farthest) = maxMovement;
+
+		//half of the distance of every center to the closest other center
+		RealMatrix centerDistances = distanceSqr(centers,centers);
+		RealVector halfDistance(k, std::numeric_limits<double>::max());
+		for(std::size_t j = 0; j != k; ++j){
+			for(std::size_t l = 0; l != k; ++l){
+				if(l != j)
+					halfDistance(j) = std::min(halfDistance(j), centerDistances(j,l));
+			}
+			halfDistance(j) = 0.5 * std::sqrt(std::max(0.0, halfDistance(j)));
+		}
+
+		//compute new cluster memberships. A point can only change its cluster if the upper bound
+		//on the distance to its center exceeds the lower bound to all others. The distances of these points
+		//to all centers are computed together as matrix product
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)numBatches; ++b){
+			RealMatrix const& batch = dataset.batch(b);
+			std::vector<std::size_t> candidates;
+			for(std::size_t i = 0; i != batch.size1(); ++i){
+				std::size_t p = offsets[b] + i;
+				std::size_t c = assignment[p];
+				upper(p) += movement(c);
+				lower(p) -= (c == farthest)? secondMovement: maxMovement;
+				double bound = std::max(halfDistance(c), lower(p));
+				if(upper(p) <= bound) continue;
+				upper(p) = norm_2(row(batch,i) - row(centers,c));
+				if(upper(p) <= bound) continue;
+				candidates.push_back(i);
+			}
+			moved[b].clear();
+			movedFrom[b].clear();
+			if(candidates.empty()) continue;
+			RealMatrix candidatePoints(candidates.size(),dimension);
+			for(std::size_t i = 0; i != candidates.size(); ++i){
+				noalias(row(candidatePoints,i)) = row(batch,candidates[i]);
+			}
+			RealMatrix distances = distanceSqr(candidatePoints,centers);
+			for(std::size_t i = 0; i != candidates.size(); ++i){
+				std::size_t p = offsets[b] + candidates[i];
+				std::size_t old = assignment[p];
+				closestCenters(distances, i, assignment[p], upper(p), lower(p));
+				if(assignment[p] != old){
+					moved[b].push_back(candidates[i]);
+					movedFrom[b].push_back(old);
+				}
+			}
+		}
+
+		//update the sums with the points which changed their cluster
+		equal = true;
+		for(std::size_t b = 0; b != numBatches; ++b){
+			RealMatrix const& batch = dataset.batch(b);
+			for(std::size_t i = 0; i != moved[b].size(); ++i){
+				std::size_t p = offsets[b] + moved[b][i];
+				noalias(row(sums,movedFrom[b][i])) -= row(batch,moved[b][i]);
+				noalias(row(sums,assignment[p])) += row(batch,moved[b][i]);
+				numPoints(movedFrom[b][i]) -= 1;
+				numPoints(assignment[p]) += 1;
+				equal = false;
 			}
 		}
-		centroids.setCentroids(createDataFromRange(newCenters));
-		
-		//compute new cluster memberships and check whether they are 
-		// equal to the old one, in that case we stop after this iteration
-		Data<unsigned int> newClusterMembership = model(dataset);
-		equal = boost::equal(
-			newClusterMembership.elements(),
-			clusterMembership.labels().elements()
-		);
-		clusterMembership.labels() = newClusterMembership;
 	}
+	setCenters(centroids,centers);
 
 	// return the number of iterations
 	return iter;
@@ -104,3 +357,32 @@ std::size_t shark::kMeans(Data<RealVector> const& data, RBFLayer& model, std::si
 	model.centers() = createBatch<RealVector>(centroids.centroids().elements());
 	return iter;
 }
+
+void shark::miniBatchKMeansUpdate(RealMatrix const& batch, Centroids& centroids, RealVector& counts){
+	std::size_t k = centroids.numberOfClusters();
+	SIZE_CHECK(batch.size2() == centroids.dimension());
+	if(counts.size() != k)
+		counts = RealVector(k, 0.0);
+	RealMatrix centers = createBatch<RealVector>(centroids.centroids().elements());
+	RealMatrix distances = distanceSqr(batch,centers);
+	for(std::size_t i = 0; i != batch.size1(); ++i){
+		std::size_t c = arg_min(row(distances,i));
+		//every center is the running mean of all points assigned to it
+		counts(c) += 1;
+		double learningRate = 1.0 / counts(c);
+		noalias(row(centers,c)) += learningRate * (row(batch,i) - row(centers,c));
+	}
+	setCenters(centroids,centers);
+}
+
+void shark::miniBatchKMeans(Data<RealVector> const& dataset, std::size_t k, Centroids& centroids, std::size_t iterations){
+	SIZE_CHECK(k <= dataset.numberOfElements());
+	if (centroids.numberOfClusters() != k){
+		initKMeansParallel(dataset,k,centroids);
+	}
+	RealVector counts(k, 0.0);
+	for(std::size_t iter = 0; iter != iterations; ++iter){
+		std::size_t b = Rng::discrete(0, dataset.numberOfBatches() - 1);
+		miniBatchKMeansUpdate(dataset.batch(b), centroids, counts);
+	}
+}
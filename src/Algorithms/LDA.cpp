@@ -34,6 +34,7 @@
 #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/Trainers/LDA.h>
 #include <shark/LinAlg/solveSystem.h>
+#include <shark/Data/Statistics.h>
 
 using namespace shark;
 
@@ -50,11 +51,10 @@ void LDA::train(LinearClassifier<>& model, LabeledData<RealVector,unsigned int>
 	RealMatrix means(classes, dim,0.0);
 	RealMatrix covariance(dim, dim,0.0);
 	
-	//we compute the data batch wise
+	//we compute the class means batch wise
 	for(auto const& batch: dataset.batches()){
 		UIntVector const& labels = batch.label;
 		RealMatrix const& points = batch.input;
-		//load batch and update mean
 		std::size_t currentBatchSize = points.size1();
 		for (std::size_t e=0; e != currentBatchSize; e++){
 			//update mean and class count for this sample
@@ -62,9 +62,12 @@ void LDA::train(LinearClassifier<>& model, LabeledData<RealVector,unsigned int>
 			++num(c);
 			noalias(row(means,c))+=row(points,e);
 		}
-		//update second moment matrix
-		noalias(covariance) += prod(trans(points),points);
 	}
+	//second moment matrix
+	typedef LabeledData<RealVector,unsigned int>::const_batch_reference BatchRef;
+	scatterMatrix(dataset,[](BatchRef batch) -> RealMatrix{
+		return batch.input;
+	},covariance);
 	covariance/=inputs-classes;
 	//calculate mean and the covariance matrix from second moment
 	for (std::size_t c = 0; c != classes; c++){
@@ -119,24 +122,28 @@ void LDA::train(LinearClassifier<>& model, WeightedLabeledData<RealVector,unsign
 	double weightSum = sumOfWeights(dataset);
 	RealVector classWeight(classes,0.0);
 	
-	//we compute the data batch wise
+	//we compute the class means batch wise
 	for(auto const& batch: dataset.batches()){
 		UIntVector const& labels = batch.data.label;
-		RealMatrix points = batch.data.input;
+		RealMatrix const& points = batch.data.input;
 		RealVector const& weights = batch.weight;
-		//load batch and update mean
 		std::size_t currentBatchSize = points.size1();
 		for (std::size_t e=0; e != currentBatchSize; e++){
 			//update mean and class count for this sample
 			std::size_t c = labels(e);
 			classWeight(c) += weights(e);
 			noalias(row(means,c)) += weights(e)*row(points,e);
-			row(points,e) *= std::sqrt(weights(e));
-			
 		}
-		//update second moment matrix
-		noalias(covariance) += prod(trans(points),points);
 	}
+	//weighted second moment matrix: the scatter of the points scaled by the square root of their weights
+	typedef WeightedLabeledData<RealVector,unsigned int>::const_batch_reference BatchRef;
+	scatterMatrix(dataset,[](BatchRef batch) -> RealMatrix{
+		RealMatrix points = batch.data.input;
+		for (std::size_t e=0; e != points.size1(); e++){
+			row(points,e) *= std::sqrt(batch.weight(e));
+		}
+		return points;
+	},covariance);
 	covariance /= weightSum;
 	
 	//calculate mean and the covariance matrix from second moment
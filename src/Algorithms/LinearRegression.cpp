@@ -33,6 +33,7 @@
 //===========================================================================
 #define SHARK_COMPILE_DLL
 #include <shark/LinAlg/solveSystem.h>
+#include <shark/Data/Statistics.h>
 #include <shark/Algorithms/Trainers/LinearRegression.h>
 
 using namespace shark;
@@ -45,37 +46,29 @@ LinearRegression::LinearRegression(double regularization){
 void LinearRegression::train(LinearModel<>& model, LabeledData<RealVector, RealVector> const& dataset){
 	std::size_t inputDim = inputDimension(dataset);
 	std::size_t outputDim = labelDimension(dataset);
-	std::size_t numInputs = dataset.numberOfElements();
-	std::size_t numBatches = dataset.numberOfBatches();
 
 	//Let P be the matrix of points with n rows and X=(P|1). the 1 rpresents the bias weight
 	//Let A = X^T X + lambda * I
 	//than whe have (for lambda = 0)
 	//A = ( P^T P  P^T 1)
 	//       ( 1^T P  1^T1)
-	RealMatrix matA(inputDim+1,inputDim+1,0.0);
-	blas::Blocking<RealMatrix> Ablocks(matA,inputDim,inputDim);
-	//compute A and the label matrix batchwise
+	//we also need to compute X^T L= (P^TL, 1^T L) where L is the matrix of labels.
+	//both are blocks of the scatter matrix of Z=(P|1|L), which we compute in a single parallel pass
 	typedef LabeledData<RealVector, RealVector>::const_batch_reference BatchRef;
-	for (std::size_t b=0; b != numBatches; b++){
-		BatchRef batch = dataset.batch(b);
-		noalias(Ablocks.upperLeft()) += prod(trans(batch.input),batch.input);
-		noalias(column(Ablocks.upperRight(),0))+=sum_rows(batch.input);
-	}
-	row(Ablocks.lowerLeft(),0) = column(Ablocks.upperRight(),0);
-	matA(inputDim,inputDim) = numInputs;
+	RealMatrix ZTZ;
+	scatterMatrix(dataset,[&](BatchRef batch) -> RealMatrix{
+		std::size_t batchSize = batch.input.size1();
+		RealMatrix Z(batchSize,inputDim + 1 + outputDim);
+		noalias(columns(Z,0,inputDim)) = batch.input;
+		noalias(column(Z,inputDim)) = blas::repeat(1.0,batchSize);
+		noalias(columns(Z,inputDim + 1,inputDim + 1 + outputDim)) = batch.label;
+		return Z;
+	},ZTZ);
+	RealMatrix matA = subrange(ZTZ,0,inputDim + 1,0,inputDim + 1);
+	RealMatrix XTL = subrange(ZTZ,0,inputDim + 1,inputDim + 1,inputDim + 1 + outputDim);
 	//X^TX+=lambda* I
-	diag(Ablocks.upperLeft()) += m_regularization;
-	
-	
-	//we also need to compute X^T L= (P^TL, 1^T L) where L is the matrix of labels 
-	RealMatrix XTL(inputDim + 1,outputDim,0.0);
-	for (std::size_t b=0; b != numBatches; b++){
-		BatchRef batch = dataset.batch(b);
-		auto PTL = subrange(XTL,0,inputDim,0,outputDim);
-		noalias(PTL) += prod(trans(batch.input),batch.label);
-		noalias(row(XTL,inputDim))+=sum_rows(batch.label);
-	}	
+	for(std::size_t i = 0; i != inputDim; ++i)
+		matA(i,i) += m_regularization;
 	
 	//we solve the system A Beta = X^T L
 	//usually this is solved via the moore penrose inverse:
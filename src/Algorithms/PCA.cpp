@@ -35,9 +35,31 @@
 #include <shark/LinAlg/eigenvalues.h>
 #include <shark/Data/Statistics.h>
 #include <shark/Algorithms/Trainers/PCA.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Rng/GlobalRng.h>
 
 using namespace shark;
 
+namespace{
+/// Computes Q C for the covariance matrix C of the data and a matrix Q with the directions as rows,
+/// using one parallel pass over the batches, without forming C.
+RealMatrix covarianceProduct(UnlabeledData<RealVector> const& inputs, RealVector const& mean, RealMatrix const& Q){
+	RealMatrix result(Q.size1(),Q.size2(),0.0);
+	int numBatches = (int) inputs.numberOfBatches();
+	SHARK_PARALLEL_FOR(int b = 0; b < numBatches; ++b){
+		std::size_t batchSize = inputs.batch(b).size1();
+		RealMatrix X = inputs.batch(b)-repeat(mean,batchSize);
+		RealMatrix XQT = prod(X,trans(Q));
+		RealMatrix batchResult = prod(trans(XQT),X);
+		SHARK_CRITICAL_REGION{
+			noalias(result) += batchResult;
+		}
+	}
+	result /= inputs.numberOfElements();
+	return result;
+}
+}
+
 /// Set the input data, which is stored in the PCA object.
 void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 	SHARK_CHECK(inputs.numberOfElements() >= 2, "[PCA::train] input needs to contain at least two points");
@@ -45,6 +67,11 @@ void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 	PCAAlgorithm algorithm = m_algorithm;
 	m_n = dataDimension(inputs); 
 	
+	if(algorithm == RANDOMIZED){
+		SHARK_CHECK(m_components > 0, "[PCA::setData] the randomized algorithm requires the number of components");
+		randomizedPCA(inputs, m_components);
+		return;
+	}
 	if(algorithm == AUTO)  {
 		if(m_n > m_l) algorithm = SMALL_SAMPLE; // more attributes than data points
 		else algorithm = STANDARD;
@@ -110,10 +137,115 @@ void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 	}
 }
 
+/// Randomized range finder (Halko, Martinsson and Tropp, 2011) applied to the covariance matrix.
+/// A random subspace of dimension components+oversampling is refined by power iterations and
+/// the covariance is projected onto it. Only products of the covariance with the basis are
+/// needed, each computed by a parallel pass over the data.
+void PCA::randomizedPCA(UnlabeledData<RealVector> const& inputs, std::size_t components) {
+	SHARK_CHECK(inputs.numberOfElements() >= 2, "[PCA::train] input needs to contain at least two points");
+	SHARK_CHECK(components > 0, "[PCA::train] number of components must be positive");
+	m_l = inputs.numberOfElements();
+	m_n = dataDimension(inputs);
+	m_mean = shark::mean(inputs);
+	components = std::min(components, std::min(m_n,m_l));
+	std::size_t subspaceSize = std::min(components + m_oversampling, m_n);
+
+	//random orthonormal basis, stored as rows
+	RealMatrix Q(subspaceSize,m_n);
+	for(std::size_t i = 0; i != subspaceSize; ++i){
+		for(std::size_t j = 0; j != m_n; ++j){
+			Q(i,j) = Rng::gauss();
+		}
+	}
+	blas::detail::orthonormalizeRows(Q);
+	for(std::size_t iter = 0; iter <= m_powerIterations; ++iter){
+		Q = covarianceProduct(inputs,m_mean,Q);
+		blas::detail::orthonormalizeRows(Q);
+	}
+
+	//Rayleigh-Ritz: eigendecomposition of the covariance projected onto the subspace
+	RealMatrix QC = covarianceProduct(inputs,m_mean,Q);
+	RealMatrix H = prod(Q,trans(QC));
+	RealMatrix W;
+	RealVector lambda;
+	eigensymm(H,W,lambda);
+	m_eigenvectors = prod(trans(Q),columns(W,0,components));
+	m_eigenvalues = subrange(lambda,0,components);
+}
+
+/// Adds the data to the decomposition batch by batch.
+void PCA::updateData(UnlabeledData<RealVector> const& inputs) {
+	for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+		updateBatch(inputs.batch(b));
+	}
+}
+
+/// Incremental PCA, see Ross et al. "Incremental learning for robust visual tracking" (2008).
+/// The current decomposition is represented by the k scaled eigenvectors
+/// \f$ \sqrt{l \lambda_i} u_i \f$. Together with the centered batch and a row correcting
+/// for the shift of the mean, they form a small matrix M with the same scatter matrix as all
+/// data seen so far, up to the truncated components. The new decomposition is the truncated SVD of M.
+void PCA::updateBatch(RealMatrix const& batch) {
+	std::size_t batchSize = batch.size1();
+	if(batchSize == 0) return;
+	if(m_l == 0){
+		m_n = batch.size2();
+		m_mean = RealVector(m_n,0.0);
+		m_eigenvalues.resize(0);
+		m_eigenvectors.resize(m_n,0);
+	}
+	SIZE_CHECK(batch.size2() == m_n);
+
+	RealVector batchMean = sum_rows(batch) / double(batchSize);
+	std::size_t oldComponents = m_eigenvalues.size();
+	std::size_t extraRow = m_l > 0 ? 1 : 0;
+	std::size_t numRows = oldComponents + batchSize + extraRow;
+	RealMatrix M(numRows,m_n);
+	for(std::size_t i = 0; i != oldComponents; ++i){
+		row(M,i) = std::sqrt(std::max(m_eigenvalues(i),0.0) * m_l) * column(m_eigenvectors,i);
+	}
+	noalias(rows(M,oldComponents,oldComponents+batchSize)) = batch - repeat(batchMean,batchSize);
+	if(extraRow){
+		double weight = std::sqrt(double(m_l) * batchSize / double(m_l + batchSize));
+		noalias(row(M,numRows-1)) = weight * (m_mean - batchMean);
+	}
+	m_mean = (double(m_l) * m_mean + double(batchSize) * batchMean) / double(m_l + batchSize);
+	m_l += batchSize;
+
+	std::size_t components = m_components > 0 ? m_components : m_n;
+	components = std::min(components, std::min(m_n, std::min(m_l, numRows)));
+	RealVector singularValues2;
+	if(m_n <= numRows){
+		//right singular vectors are the eigenvectors of M^T M
+		RealMatrix MTM = prod(trans(M),M);
+		RealMatrix V;
+		eigensymm(MTM,V,singularValues2);
+		m_eigenvectors = columns(V,0,components);
+	}else{
+		//compute the left singular vectors from M M^T and map them back
+		RealMatrix MMT = prod(M,trans(M));
+		RealMatrix U;
+		eigensymm(MMT,U,singularValues2);
+		RealMatrix VT = prod(trans(columns(U,0,components)),M);
+		for(std::size_t i = 0; i != components; ++i){
+			if(singularValues2(i) > 1.e-15 * singularValues2(0))
+				row(VT,i) /= std::sqrt(singularValues2(i));
+			else
+				row(VT,i).clear();//replaced by an arbitrary orthogonal direction
+		}
+		blas::detail::orthonormalizeRows(VT);
+		m_eigenvectors = trans(VT);
+	}
+	m_eigenvalues.resize(components);
+	for(std::size_t i = 0; i != components; ++i){
+		m_eigenvalues(i) = std::max(singularValues2(i),0.0) / m_l;
+	}
+}
+
 //! Returns a model mapping the original data to the
 //! m-dimensional PCA coordinate system.
 void PCA::encoder(LinearModel<>& model, std::size_t m) {
-	if(!m) m = std::min(m_n,m_l);
+	if(!m) m = std::min(std::min(m_n,m_l),m_eigenvectors.size2());
 	
 	RealMatrix A = trans(columns(m_eigenvectors, 0, m) );
 	RealVector offset = -prod(A, m_mean);
@@ -137,7 +269,7 @@ void PCA::encoder(LinearModel<>& model, std::size_t m) {
 //! m-dimensional PCA coordinate system back to the
 //! n-dimensional original coordinate system.
 void PCA::decoder(LinearModel<>& model, std::size_t m) {
-	if(!m) m = std::min(m_n,m_l);
+	if(!m) m = std::min(std::min(m_n,m_l),m_eigenvectors.size2());
 	if( m == m_n && !m_whitening){
 		model.setStructure(m_eigenvectors, m_mean);
 	}
@@ -34,6 +34,7 @@
 #define SHARK_COMPILE_DLL
 #include <shark/Models/Clustering/Centroids.h>
 #include <shark/Data/DataView.h>
+#include <boost/math/special_functions/fpclassify.hpp>
 
 using namespace shark;
 
@@ -87,16 +88,34 @@ RealMatrix Centroids::distances(BatchInputType const& patterns) const{
 	std::size_t numClusters = numberOfClusters();
 	std::size_t numPatterns = boost::size(patterns);
 	RealMatrix distances(numPatterns, numClusters);
-	//first evaluate distance to all centroids;
+	//first evaluate squared distance to all centroids directly into the result
 	std::size_t batchBegin = 0;
 	for (std::size_t i=0; i != m_centroids.numberOfBatches(); i++){
 		std::size_t batchEnd = batchBegin +boost::size(m_centroids.batch(i));
-		columns(distances,batchBegin,batchEnd) = sqrt(distanceSqr(patterns, m_centroids.batch(i)));
+		auto block = columns(distances,batchBegin,batchEnd);
+		distanceSqr(patterns, m_centroids.batch(i), block);
 		batchBegin = batchEnd;
 	}
+	noalias(distances) = sqrt(distances);
 	return distances;
 }
 
+namespace{
+//normalizes the memberships of a pattern to sum to one. If the sum over- or underflows
+//the membership is shared equally by the clusters with the largest kernel value.
+template<class Vector>
+void normalizeMemberships(Vector membership){
+	double total = sum(membership);
+	if(!(total > 0) || !(boost::math::isfinite)(total)){
+		double maximum = max(membership);
+		for (std::size_t j=0; j != membership.size(); j++)
+			membership(j) = membership(j) == maximum? 1.0 : 0.0;
+		total = sum(membership);
+	}
+	membership /= total;
+}
+}
+
 RealVector Centroids::softMembership(RealVector const& pattern) const{
 	std::size_t numClusters = numberOfClusters();
 	RealVector membership(numClusters);
@@ -111,7 +130,7 @@ RealVector Centroids::softMembership(RealVector const& pattern) const{
 	for (std::size_t i=0; i != numClusters; i++){
 		membership(i) = membershipKernel(membership(i));
 	}
-	membership /= sum(membership);
+	normalizeMemberships(subrange(membership,0,numClusters));
 	return membership;
 }
 
@@ -123,7 +142,7 @@ RealMatrix Centroids::softMembership(BatchInputType const& patterns) const{
 	for (std::size_t i=0; i != numPatterns; i++){
 		for (std::size_t j=0; j != numClusters; j++)
 			membership(i,j) = membershipKernel(membership(i,j));
-		row(membership,i) /= sum(row(membership,i));
+		normalizeMemberships(row(membership,i));
 	}
 	return membership;
 }
@@ -104,16 +104,19 @@ void RBFLayer::eval(BatchInputType const& patterns, BatchOutputType& output, Sta
 	InternalState& s = state.toState<InternalState>();
 	s.resize(numPatterns,outputSize());
 
-	//we need to add separate gamma parameters for every evaluation
-	noalias(s.norm2) = distanceSqr(patterns,m_centers);
+	//squared distances of all patterns to all centers as one matrix-matrix product
+	distanceSqr(patterns,m_centers,s.norm2);
 	
-	//every center has it's own value of gamma, so we need to multiply the i-th column 
-	//of the norm with m_gamma(i) and to normalize it, we have to subtract the normalization
-	// constant.
-	noalias(s.p) = exp(
-		-element_prod(repeat(m_gamma,numPatterns),s.norm2) 
-		- repeat(m_logNormalization,numPatterns)
-	);
+	//every center has it's own value of gamma, so we need to multiply the j-th column 
+	//of the norm with m_gamma(j) and to normalize it, we have to subtract the normalization
+	//constant. This is done in a single pass over the distances. As the distances are clipped
+	//at zero, the density never exceeds its value at the center.
+	std::size_t numNeurons = outputSize();
+	for(std::size_t i = 0; i != numPatterns; ++i){
+		for(std::size_t j = 0; j != numNeurons; ++j){
+			s.p(i,j) = std::exp(-m_gamma(j) * s.norm2(i,j) - m_logNormalization(j));
+		}
+	}
 	
 	noalias(output) = s.p;
 }